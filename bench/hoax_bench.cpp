@@ -0,0 +1,326 @@
+#include "hoax.h"
+#include "stats.h"
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <map>
+#include <getopt.h>
+#include <spot/parseaut/public.hh>
+
+/** Value set by "-r", the number of times every game is solved. */
+static unsigned int flag_repeats = 5;
+
+/** Value set by "-o", the path of the CSV file to write the results to. */
+static std::filesystem::path flag_path_out;
+
+/** Value set by "-B", the path of the baseline CSV file to compare against. */
+static std::filesystem::path flag_path_baseline;
+
+/** Flag set by "-u" */
+static int flag_update_baseline = 0;
+
+/** Value set by "-x", the relative slowdown that counts as a regression. */
+static double flag_tolerance = 0.10;
+
+/** Flag set by "-n" */
+static int flag_no_spot = 0;
+
+/** Slowdowns below this many seconds are noise, and never a regression. */
+const double REGRESSION_MIN_SEC = 0.005;
+
+/** The phases that are timed, in CSV column order. */
+const std::vector<std::string> PHASES = {"parse", "expand", "priority", "solve", "total", "spot"};
+
+/** The timings of all repeats of a single game. */
+struct GameTimes {
+  std::string path_in;
+  /** The verdict of hoax, REAL or UNREAL. */
+  std::string result;
+  /** The verdict of spot's synthesis, or empty iff. it did not run. */
+  std::string result_spot;
+  unsigned int num_states = 0;
+  unsigned int num_edges = 0;
+  /** The seconds of every repeat, per phase. */
+  std::map<std::string, std::vector<double>> phases;
+};
+
+/** Get the nearest-rank percentile of a sample.
+
+    @param[in] sample The measurements, in any order
+    @param[in] p The percentile, in [0, 100]
+    @return The percentile, or 0 iff. the sample is empty
+*/
+static double percentile(std::vector<double> sample, const double p) {
+  if (sample.empty())
+    return 0;
+  std::sort(sample.begin(), sample.end());
+  const size_t rank = std::ceil(p / 100.0 * sample.size());
+  return sample[std::min(sample.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+/** Read the game paths of a benchmark suite file.
+
+    A suite file lists one eHOA input file per line, relative to the working
+    directory. Empty lines and lines starting with '#' are ignored.
+*/
+static std::vector<std::filesystem::path> read_suite(const std::filesystem::path &path_suite) {
+  std::ifstream in(path_suite);
+  if (!in.is_open())
+    throw std::runtime_error("Could not open ifstream to read suite " + path_suite.string());
+
+  std::vector<std::filesystem::path> paths_in;
+  std::string line;
+  while (std::getline(in, line)) {
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (line.empty() || line[0] == '#')
+      continue;
+    paths_in.push_back(line);
+  }
+  return paths_in;
+}
+
+/** Parse, expand and solve a single game several times.
+
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @return The timings of every phase of every repeat
+*/
+static GameTimes bench_game(const std::filesystem::path &path_in) {
+  GameTimes times;
+  times.path_in = path_in.string();
+
+  for (unsigned int repeat = 0; repeat < flag_repeats; repeat++) {
+    hoax::Stats stats_parse;
+    spot::parsed_aut_ptr pa;
+    {
+      hoax::PhaseTimer timer(stats_parse.time_parse);
+      pa = spot::parse_aut(path_in, spot::make_bdd_dict());
+    }
+    if (pa->aborted || pa->aut == nullptr)
+      throw std::runtime_error("PARSE ERR");
+    if (pa->aut->get_named_prop<bdd>(PROP_SPOT_SYNTH_OUTPUT) == nullptr)
+      throw std::runtime_error("PROP MISSING " PROP_SPOT_SYNTH_OUTPUT);
+
+    /* The benchmark runs without a runtime budget. */
+    hoax::HOAxParityTwA hptwa(pa->aut, std::make_shared<hoax::CancelToken>());
+    hptwa.stats.time_parse = stats_parse.time_parse;
+    const bool SOL_COMPUTED = !hptwa.solve_parity_game();
+
+    const hoax::Stats &stats = hptwa.stats;
+    times.phases["parse"].push_back(stats.time_parse);
+    times.phases["expand"].push_back(stats.time_expand);
+    times.phases["priority"].push_back(stats.time_priority);
+    times.phases["solve"].push_back(stats.time_solve);
+    times.phases["total"].push_back(stats.time_parse + stats.time_expand + stats.time_priority + stats.time_solve);
+
+    const std::string result = SOL_COMPUTED ? "REAL" : "UNREAL";
+    std::string result_spot;
+    if (!flag_no_spot) {
+      double time_spot = 0;
+      bool SOL_ACTUAL;
+      {
+        hoax::PhaseTimer timer(time_spot);
+        SOL_ACTUAL = hoax::solve_spot(pa->aut);
+      }
+      times.phases["spot"].push_back(time_spot);
+      result_spot = SOL_ACTUAL ? "REAL" : "UNREAL";
+    }
+
+    if (repeat > 0 && (result != times.result || result_spot != times.result_spot))
+      throw std::runtime_error("NONDETERMINISTIC RESULT");
+    times.result = result;
+    times.result_spot = result_spot;
+    times.num_states = hptwa.arena.num_states;
+    times.num_edges = hptwa.arena.num_edges;
+  }
+  return times;
+}
+
+/** Write the median and p90 of every phase of every game as CSV. */
+static void write_csv(std::ostream &out, const std::vector<GameTimes> &games) {
+  out << "file,result,spot,states,edges,repeats";
+  for (const std::string &phase : PHASES)
+    out << "," << phase << "_median," << phase << "_p90";
+  out << "\n";
+
+  out << std::setprecision(6) << std::fixed;
+  for (const GameTimes &game : games) {
+    out << "\"" << game.path_in << "\"," << game.result << "," << game.result_spot << ","
+        << game.num_states << "," << game.num_edges << "," << flag_repeats;
+    for (const std::string &phase : PHASES) {
+      auto it = game.phases.find(phase);
+      if (it == game.phases.end())
+        out << ",,";
+      else
+        out << "," << percentile(it->second, 50) << "," << percentile(it->second, 90);
+    }
+    out << "\n";
+  }
+}
+
+/** The expected verdict and median total time of a game in the baseline. */
+struct Baseline {
+  /** The verdict, or empty iff. unknown. */
+  std::string result;
+  /** The median total time in seconds, or -1 iff. unknown. */
+  double total_median = -1;
+};
+
+/** Read the verdict and median total time per game from a CSV file of `write_csv`.
+
+    The columns are found by their header, so a baseline of an older
+    format without some column simply lacks that value.
+*/
+static std::map<std::string, Baseline> read_baseline(const std::filesystem::path &path_baseline) {
+  std::ifstream in(path_baseline);
+  if (!in.is_open())
+    throw std::runtime_error("Could not open ifstream to read baseline " + path_baseline.string());
+
+  std::map<std::string, Baseline> baselines;
+  std::string line;
+  std::getline(in, line);
+  size_t col_result = 0, col_total = 0;
+  {
+    std::stringstream header(line);
+    std::string name;
+    for (size_t col = 0; std::getline(header, name, ','); col++) {
+      if (name == "result")
+        col_result = col;
+      else if (name == "total_median")
+        col_total = col;
+    }
+  }
+  while (std::getline(in, line)) {
+    /* The file name is the only quoted column; the others hold no commas. */
+    const size_t path_end = line.find("\",");
+    if (line.empty() || line[0] != '"' || path_end == std::string::npos)
+      continue;
+    const std::string path_in = line.substr(1, path_end - 1);
+
+    std::stringstream row(line.substr(path_end + 2));
+    std::string cell;
+    Baseline &baseline = baselines[path_in];
+    for (size_t col = 1; std::getline(row, cell, ','); col++) {
+      if (col == col_result)
+        baseline.result = cell;
+      else if (col == col_total && !cell.empty())
+        baseline.total_median = std::stod(cell);
+    }
+  }
+  return baselines;
+}
+
+int main(int argc, char *argv[]) {
+  while (true) {
+    switch (getopt(argc, argv, "hr:o:B:ux:n")) {
+      case 'r':
+        flag_repeats = std::max(1, atoi(optarg));
+        continue;
+
+      case 'o':
+        flag_path_out = optarg;
+        continue;
+
+      case 'B':
+        flag_path_baseline = optarg;
+        continue;
+
+      case 'u':
+        flag_update_baseline = 1;
+        continue;
+
+      case 'x':
+        flag_tolerance = atof(optarg);
+        continue;
+
+      case 'n':
+        flag_no_spot = 1;
+        continue;
+
+      case 'h': {
+        std::cout << "Usage: hoax_bench [options] [suite files]" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  -h             Show this help message and exit" << std::endl;
+        std::cout << "  -r N           Solve every game N times (default " << flag_repeats << ")" << std::endl;
+        std::cout << "  -o PATH        Write the median and p90 time per phase and game as CSV to PATH" << std::endl;
+        std::cout << "  -B PATH        Compare the verdict and median total time per game against the baseline CSV at PATH" << std::endl;
+        std::cout << "  -u             Overwrite the baseline with the current results; implied if it does not exist" << std::endl;
+        std::cout << "  -x FRAC        The relative slowdown that counts as a regression (default " << flag_tolerance << ")" << std::endl;
+        std::cout << "  -n             Do not time spot's synthesis baseline" << std::endl;
+        std::cout << "Arguments:" << std::endl;
+        std::cout << "  Suite files that list one eHOA input file per line" << std::endl;
+        exit(0);
+      }
+    }
+    /* End of options. */
+    break;
+  }
+
+  std::vector<std::filesystem::path> paths_in;
+  for (int i = optind; i < argc; i++) {
+    const std::vector<std::filesystem::path> suite = read_suite(argv[i]);
+    paths_in.insert(paths_in.end(), suite.begin(), suite.end());
+  }
+
+  std::vector<GameTimes> games;
+  int ret = 0;
+  for (const auto &path_in : paths_in) {
+    try {
+      games.push_back(bench_game(path_in));
+    } catch (std::runtime_error &e) {
+      std::cout << "SKIP\t" << e.what() << "\t" << path_in.string() << std::endl;
+      continue;
+    }
+    const GameTimes &game = games.back();
+    const bool mismatch = !game.result_spot.empty() && game.result_spot != game.result;
+    std::cout << (mismatch ? "MISMATCH" : game.result) << "\t"
+              << std::to_string(percentile(game.phases.at("total"), 50)) << "s\t"
+              << game.path_in << std::endl;
+    if (mismatch)
+      ret = 1;
+  }
+
+  if (!flag_path_out.empty()) {
+    std::filesystem::create_directories(flag_path_out.parent_path());
+    std::ofstream out(flag_path_out);
+    write_csv(out, games);
+  } else {
+    write_csv(std::cout, games);
+  }
+
+  if (flag_path_baseline.empty())
+    return ret;
+
+  /* Compare against the baseline, or establish it. */
+  if (flag_update_baseline || !std::filesystem::exists(flag_path_baseline)) {
+    std::filesystem::create_directories(flag_path_baseline.parent_path());
+    std::ofstream out(flag_path_baseline);
+    write_csv(out, games);
+    std::cout << "BASELINE\twritten\t" << flag_path_baseline.string() << std::endl;
+    return ret;
+  }
+
+  const std::map<std::string, Baseline> baselines = read_baseline(flag_path_baseline);
+  for (const GameTimes &game : games) {
+    auto it = baselines.find(game.path_in);
+    if (it == baselines.end())
+      continue;
+    const Baseline &baseline = it->second;
+    /* A changed verdict is a regression, however fast the game got. */
+    if (!baseline.result.empty() && baseline.result != game.result) {
+      std::cout << "REGRESSION\t" << baseline.result << " -> " << game.result << "\t" << game.path_in << std::endl;
+      ret = 1;
+    }
+    const double median = percentile(game.phases.at("total"), 50);
+    if (baseline.total_median >= 0 && median > baseline.total_median * (1 + flag_tolerance) &&
+        median - baseline.total_median > REGRESSION_MIN_SEC) {
+      std::cout << "REGRESSION\t" << std::to_string(baseline.total_median) << "s -> "
+                << std::to_string(median) << "s\t" << game.path_in << std::endl;
+      ret = 1;
+    }
+  }
+  return ret;
+}
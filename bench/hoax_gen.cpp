@@ -0,0 +1,262 @@
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <getopt.h>
+
+/** Value set by "-f", the structural family of the generated game. */
+static std::string flag_family = "random";
+
+/** Value set by "-n", the number of states. */
+static unsigned int flag_states = 100;
+
+/** Value set by "-a", the number of branches of the "odd player" per state. */
+static unsigned int flag_adam = 2;
+
+/** Value set by "-d", the number of branches of the "even player" per "odd player" branch. */
+static unsigned int flag_eve = 2;
+
+/** Value set by "-p", the number of priorities (acceptance sets). */
+static unsigned int flag_priorities = 4;
+
+/** Value set by "-c", the number of controllable APs; 0 means the minimum. */
+static unsigned int flag_ctrl = 0;
+
+/** Value set by "-g", the number of uncontrollable APs per guard; 0 means the minimum.
+
+    This is the knob that scales the expansion: it creates one "even player"
+    state for every valuation of these APs, i.e. `2^flag_guard` per state.
+*/
+static unsigned int flag_guard = 0;
+
+/** Value set by "-s", the seed of the random number generator. */
+static uint64_t flag_seed = 0;
+
+/** Value set by "-o", the path of the eHOA file to write, or stdout if empty. */
+static std::filesystem::path flag_path_out;
+
+/** The size of the output buffer; the games can have millions of states. */
+const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+/** The number of bits needed to encode the given number of branches. */
+static unsigned int index_bits(const unsigned int branches) {
+  unsigned int bits = 0;
+  while ((1u << bits) < branches)
+    bits++;
+  return bits;
+}
+
+/** Get the guards that select a branch by a binary index over some APs.
+
+    Every valuation `v` of the `bits` APs, starting at AP `ap_first`, is
+    folded by xor-ing its chunks of `index_bits(branches)` bits, and selects
+    branch `fold(v) % branches`. So the guards partition all valuations,
+    every branch is selected by `2^bits / branches` cubes, rounded, and
+    with at least two branches every guard depends on all `bits` APs.
+
+    @param[in] branches The number of branches
+    @param[in] ap_first The index of the first AP of the binary index
+    @param[in] bits The number of APs of the binary index
+    @return The HOA label expression of every branch
+*/
+static std::vector<std::string> index_guards(const unsigned int branches, const unsigned int ap_first,
+                                             const unsigned int bits) {
+  std::vector<std::string> guards(branches);
+  if (bits == 0) {
+    guards[0] = "t";
+    return guards;
+  }
+  const unsigned int width = std::max(1u, index_bits(branches));
+  for (uint64_t v = 0; v < (uint64_t(1) << bits); v++) {
+    uint64_t fold = 0;
+    for (unsigned int shift = 0; shift < bits; shift += width)
+      fold ^= (v >> shift) & ((uint64_t(1) << width) - 1);
+    std::string cube;
+    for (unsigned int bit = 0; bit < bits; bit++)
+      cube += std::string(bit ? "&" : "") + ((v >> bit) & 1 ? "" : "!") + std::to_string(ap_first + bit);
+    std::string &guard = guards[fold % branches];
+    guard += (guard.empty() ? "(" : " | (") + cube + ")";
+  }
+  return guards;
+}
+
+/** Get the "parity max even" acceptance condition with the given number of sets. */
+static std::string parity_max_even(const unsigned int num_sets) {
+  std::string acc;
+  for (unsigned int i = num_sets; i-- > 0; ) {
+    const bool even = i % 2 == 0;
+    acc += (even ? "Inf(" : "Fin(") + std::to_string(i) + ")";
+    if (i > 0)
+      acc += even ? " | (" : " & (";
+  }
+  return acc + std::string(num_sets > 0 ? num_sets - 1 : 0, ')');
+}
+
+/** Write a synthetic parity game in eHOA format.
+
+    Every state is owned by the "odd player" (Adam), who first picks one of
+    `flag_adam` branches with the uncontrollable APs. The "even player" (Eve)
+    then picks one of `flag_eve` successors with the controllable APs. With
+    at least two branches, every guard depends on all uncontrollable APs, and
+    the expansion creates one "even player" state per valuation of them.
+
+    The families are:
+      random     Uniformly random successors and priorities.
+      ladder     State i moves to the next states i+1, i+2, ..., and has
+                 priority i modulo the number of priorities.
+      nested     Nested cycles: state i has priority i (capped at the
+                 highest priority), and may stay in its own cycle, or escape
+                 to lower levels, from the bottom to the top level.
+*/
+static void write_game(std::ostream &out) {
+  const unsigned int bits_eve = index_bits(flag_eve);
+  const unsigned int bits_adam = std::max(index_bits(flag_adam), flag_guard);
+  const unsigned int num_ctrl = std::max(flag_ctrl, bits_eve);
+  const unsigned int num_unctrl = bits_adam;
+
+  /* The controllable APs come first, then the uncontrollable APs. */
+  const std::vector<std::string> guards_eve = index_guards(flag_eve, 0, bits_eve);
+  const std::vector<std::string> guards_adam = index_guards(flag_adam, num_ctrl, bits_adam);
+  const unsigned int degree = flag_adam * flag_eve;
+
+  out << "HOA: v1\n";
+  out << "name: \"hoax_gen -f " << flag_family << " -n " << flag_states << " -a " << flag_adam
+      << " -d " << flag_eve << " -p " << flag_priorities << " -c " << num_ctrl
+      << " -g " << bits_adam << " -s " << flag_seed << "\"\n";
+  out << "States: " << flag_states << "\n";
+  out << "Start: 0\n";
+  out << "AP: " << (num_ctrl + num_unctrl);
+  for (unsigned int ap = 0; ap < num_ctrl; ap++)
+    out << " \"c" << ap << "\"";
+  for (unsigned int ap = 0; ap < num_unctrl; ap++)
+    out << " \"u" << ap << "\"";
+  out << "\n";
+  out << "acc-name: parity max even " << flag_priorities << "\n";
+  out << "Acceptance: " << flag_priorities << " " << parity_max_even(flag_priorities) << "\n";
+  out << "properties: trans-labels explicit-labels state-acc complete colored\n";
+  out << "controllable-AP:";
+  for (unsigned int ap = 0; ap < num_ctrl; ap++)
+    out << " " << ap;
+  out << "\n";
+  out << "--BODY--\n";
+
+  std::mt19937_64 rng(flag_seed);
+  std::uniform_int_distribution<unsigned int> random_state(0, flag_states - 1);
+  std::uniform_int_distribution<unsigned int> random_priority(0, flag_priorities - 1);
+
+  for (unsigned int state = 0; state < flag_states; state++) {
+    unsigned int priority;
+    if (flag_family == "random")
+      priority = random_priority(rng);
+    else if (flag_family == "ladder")
+      priority = state % flag_priorities;
+    else
+      priority = std::min(state, flag_priorities - 1);
+    out << "State: " << state << " {" << priority << "}\n";
+
+    for (unsigned int branch = 0; branch < degree; branch++) {
+      unsigned int dst;
+      if (flag_family == "random")
+        dst = random_state(rng);
+      else if (flag_family == "ladder")
+        dst = (state + 1 + branch) % flag_states;
+      else
+        /* Branch 0 stays in the own cycle, the others escape downwards,
+          or to the top level from the bottom. */
+        dst = branch == 0 ? state : (state >= branch ? state - branch : flag_states - 1);
+
+      const unsigned int adam = branch / flag_eve;
+      const unsigned int eve = branch % flag_eve;
+      out << "[(" << guards_adam[adam] << ") & (" << guards_eve[eve] << ")] " << dst << "\n";
+    }
+  }
+  out << "--END--\n";
+}
+
+int main(int argc, char *argv[]) {
+  while (true) {
+    switch (getopt(argc, argv, "hf:n:a:d:p:c:g:s:o:")) {
+      case 'f':
+        flag_family = optarg;
+        continue;
+
+      case 'n':
+        flag_states = std::max(1L, atol(optarg));
+        continue;
+
+      case 'a':
+        flag_adam = std::max(1, atoi(optarg));
+        continue;
+
+      case 'd':
+        flag_eve = std::max(1, atoi(optarg));
+        continue;
+
+      case 'p':
+        flag_priorities = std::max(1, atoi(optarg));
+        continue;
+
+      case 'c':
+        flag_ctrl = std::max(0, atoi(optarg));
+        continue;
+
+      case 'g':
+        flag_guard = std::max(0, atoi(optarg));
+        continue;
+
+      case 's':
+        flag_seed = strtoull(optarg, nullptr, 10);
+        continue;
+
+      case 'o':
+        flag_path_out = optarg;
+        continue;
+
+      case 'h': {
+        std::cout << "Usage: hoax_gen [options]" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  -h             Show this help message and exit" << std::endl;
+        std::cout << "  -f FAMILY      The game family: random, ladder or nested (default " << flag_family << ")" << std::endl;
+        std::cout << "  -n N           The number of states (default " << flag_states << ")" << std::endl;
+        std::cout << "  -a N           The number of \"odd player\" branches per state (default " << flag_adam << ")" << std::endl;
+        std::cout << "  -d N           The number of \"even player\" successors per branch (default " << flag_eve << ")" << std::endl;
+        std::cout << "  -p N           The number of priorities (default " << flag_priorities << ")" << std::endl;
+        std::cout << "  -c N           The number of controllable APs (default: as needed for -d)" << std::endl;
+        std::cout << "  -g N           The number of uncontrollable APs every guard depends on (default: as needed for -a); the guards and the expansion grow with 2^N" << std::endl;
+        std::cout << "  -s SEED        The seed of the random families (default " << flag_seed << ")" << std::endl;
+        std::cout << "  -o PATH        Write the game to PATH instead of stdout" << std::endl;
+        exit(0);
+      }
+    }
+    /* End of options. */
+    break;
+  }
+
+  if (flag_family != "random" && flag_family != "ladder" && flag_family != "nested") {
+    std::cerr << "Unknown game family '" << flag_family << "'" << std::endl;
+    return 1;
+  }
+
+  std::vector<char> buffer(OUTPUT_BUFFER_SIZE);
+  if (flag_path_out.empty()) {
+    std::ios::sync_with_stdio(false);
+    std::cout.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    write_game(std::cout);
+    std::cout.flush();
+    return std::cout ? 0 : 1;
+  }
+
+  std::ofstream out;
+  out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  out.open(flag_path_out);
+  if (!out.is_open()) {
+    std::cerr << "Could not open ofstream to write " << flag_path_out.string() << std::endl;
+    return 1;
+  }
+  write_game(out);
+  out.close();
+  return out ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+#include "hoax.h"
+#include "kernels.h"
+#include "utils.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <getopt.h>
+
+/** Value set by "-t", the minimum wall time of a single measurement, in seconds. */
+static double flag_min_time = 0.2;
+
+/** Value set by "-n", the number of vertices of the largest attractor arena. */
+static unsigned int flag_max_vertices = 100000;
+
+/** Value set by "-k", the largest number of uncontrollable APs to expand. */
+static unsigned int flag_max_unctrl = 16;
+
+/** The out-degree of every vertex of the generated attractor arenas. */
+const unsigned int ATTRACTOR_DEGREE = 4;
+
+/** The number of states of the generated expansion automata. */
+const unsigned int EXPAND_STATES = 8;
+
+/** The size of the universe the sets of the set benchmarks are drawn from. */
+const unsigned int SET_UNIVERSE = 100000;
+
+/** Keeps the compiler from optimizing away the benchmarked kernels. */
+static volatile size_t sink = 0;
+
+/** Time an operation, doubling the number of iterations until the
+    measurement takes at least `flag_min_time` seconds.
+
+    @param[in] op The operation to time
+    @return The mean wall time of a single operation, in nanoseconds
+*/
+template <typename F>
+static double time_op(F &&op) {
+  for (uint64_t iterations = 1; ; iterations *= 2) {
+    const hoax::budget_clock::time_point start = hoax::budget_clock::now();
+    for (uint64_t i = 0; i < iterations; i++)
+      sink = sink + op();
+    const double elapsed = hoax::seconds_since(start);
+    if (elapsed >= flag_min_time)
+      return elapsed * 1e9 / iterations;
+  }
+}
+
+/** Print a single result row. */
+static void report(const std::string &kernel, const std::string &param, const double ns_per_op,
+                   const double edges_per_op = 0) {
+  std::cout << kernel << "\t" << param << "\t" << std::fixed << std::setprecision(1)
+            << ns_per_op << " ns/op";
+  if (edges_per_op > 0)
+    std::cout << "\t" << std::scientific << std::setprecision(3)
+              << edges_per_op / ns_per_op * 1e9 << " edges/s";
+  std::cout << std::endl;
+}
+
+/** Generate a random bipartite arena with the given number of vertices.
+
+    Even vertices are "odd player" vertices, odd vertices are "even player"
+    vertices, and every vertex has `ATTRACTOR_DEGREE` successors of the other
+    player.
+*/
+static hoax::Arena random_arena(const unsigned int num_vertices, std::mt19937 &rng) {
+  std::uniform_int_distribution<uint32_t> random_half(0, num_vertices / 2 - 1);
+  std::uniform_int_distribution<int> random_priority(0, 7);
+
+  std::vector<uint32_t> offsets = {0};
+  std::vector<uint32_t> targets;
+  std::vector<bool> owners(num_vertices);
+  std::vector<int> priorities(num_vertices);
+  for (unsigned int v = 0; v < num_vertices; v++) {
+    owners[v] = v % 2 == 0;
+    priorities[v] = random_priority(rng);
+    for (unsigned int e = 0; e < ATTRACTOR_DEGREE; e++)
+      targets.push_back(2 * random_half(rng) + (owners[v] ? 1 : 0));
+    offsets.push_back(targets.size());
+  }
+  return hoax::make_arena(std::move(offsets), std::move(targets), owners, priorities,
+                          0, true, false, 8);
+}
+
+/** Time the attractor kernel of either player on the vertex sets of a policy. */
+template <typename Sets>
+static void bench_kernel_attractor(const std::string &name, const hoax::HOAxParityTwA &aut,
+                                   const std::set<int> &vertices_all, const std::set<int> &target) {
+  const unsigned int num_vertices = aut.arena.num_states;
+  const typename Sets::Set vertices = Sets::from(vertices_all, num_vertices);
+  const typename Sets::Set T = Sets::from(target, num_vertices);
+  const hoax::Kernel<Sets, true> kernel(aut);
+  for (const unsigned int player : {PEVEN, PODD}) {
+    aut.stats = hoax::Stats();
+    uint64_t calls = 0;
+    const double ns = time_op([&]() {
+      calls++;
+      const typename Sets::Set attr = kernel.attractor(vertices, T, player);
+      return size_t(std::distance(attr.begin(), attr.end()));
+    });
+    report(name, "n=" + std::to_string(num_vertices) + " player=" + std::to_string(player),
+           ns, double(aut.stats.edges_scanned) / calls);
+  }
+}
+
+/** Time the attractor of either player to a random 10% target set. */
+static void bench_attractor() {
+  std::mt19937 rng(1);
+  for (unsigned int num_vertices = 1000; num_vertices <= flag_max_vertices; num_vertices *= 10) {
+    hoax::HOAxParityTwA aut(random_arena(num_vertices, rng), std::make_shared<hoax::CancelToken>());
+    /* The attractors record the strategy of the attracted vertices. */
+    aut.strategy.assign(num_vertices, -1);
+
+    std::set<int> vertices_all, vertices_odd, vertices_even, target;
+    for (unsigned int v = 0; v < num_vertices; v++) {
+      vertices_all.insert(v);
+      (aut.arena.owner(v) ? vertices_odd : vertices_even).insert(v);
+      if (rng() % 10 == 0)
+        target.insert(v);
+    }
+
+    for (const unsigned int player : {PEVEN, PODD}) {
+      aut.stats = hoax::Stats();
+      uint64_t calls = 0;
+      const double ns = time_op([&]() {
+        calls++;
+        return hoax::attractor(vertices_all, vertices_odd, vertices_even, aut, target, player).size();
+      });
+      report("attractor", "n=" + std::to_string(num_vertices) + " player=" + std::to_string(player),
+             ns, double(aut.stats.edges_scanned) / calls);
+    }
+
+    /* The kernels on every set representation, without the adjacency matrix. */
+    bench_kernel_attractor<hoax::TreeSets>("kernel_tree", aut, vertices_all, target);
+    bench_kernel_attractor<hoax::VectorSets>("kernel_vector", aut, vertices_all, target);
+    bench_kernel_attractor<hoax::BitSets>("kernel_bitset", aut, vertices_all, target);
+
+    /* The dense attractor, on the arenas that fit an adjacency matrix. */
+    if (!hoax::DenseArena::fits(aut.arena))
+      continue;
+    aut.dense = std::make_shared<const hoax::DenseArena>(aut.arena);
+    for (const unsigned int player : {PEVEN, PODD}) {
+      const double ns = time_op([&]() {
+        return hoax::attractor_dense(vertices_all, aut, target, player).size();
+      });
+      report("attractor_dense", "n=" + std::to_string(num_vertices) + " player=" + std::to_string(player), ns);
+    }
+  }
+}
+
+/** Time the set utilities on random sets of the given densities. */
+static void bench_sets() {
+  std::mt19937 rng(2);
+  for (const double density : {0.01, 0.1, 0.5}) {
+    std::bernoulli_distribution coin(density);
+    std::set<int> s1, s2;
+    for (unsigned int v = 0; v < SET_UNIVERSE; v++) {
+      if (coin(rng))
+        s1.insert(v);
+      if (coin(rng))
+        s2.insert(v);
+    }
+
+    const std::string param = "density=" + std::to_string(density).substr(0, 4) +
+      " |s|=" + std::to_string(s1.size());
+    report("set_union", param, time_op([&]() { return hoax::operator+(s1, s2).size(); }));
+    report("set_difference", param, time_op([&]() { return hoax::operator-(s1, s2).size(); }));
+    report("set_contains", param, time_op([&]() { return size_t(hoax::contains(s1, rng() % SET_UNIVERSE)); }));
+    report("set_merge", param, time_op([&]() {
+      /* Merge copies, since merging moves the elements of one set. */
+      std::set<int> c1 = s1, c2 = s2;
+      return hoax::merge(c1, c2).size();
+    }));
+  }
+}
+
+/** Build an automaton whose every state reads k uncontrollable APs.
+
+    Every state `s` moves to `s+1` if the controllable AP holds, and else
+    stays in `s` if any of the uncontrollable APs holds. So the expansion
+    creates `2^k` "even player" states per state.
+*/
+static spot::twa_graph_ptr expansion_automaton(const unsigned int k) {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd ctrl = bdd_ithvar(aut->register_ap("c"));
+  bdd any_unctrl = bddfalse;
+  for (unsigned int ap = 0; ap < k; ap++)
+    any_unctrl |= bdd_ithvar(aut->register_ap("u" + std::to_string(ap)));
+  spot::set_synthesis_outputs(aut, ctrl);
+  aut->set_acceptance(2, spot::acc_cond::acc_code::parity_max_even(2));
+
+  aut->new_states(EXPAND_STATES);
+  aut->set_init_state(0);
+  for (unsigned int s = 0; s < EXPAND_STATES; s++) {
+    aut->new_edge(s, (s + 1) % EXPAND_STATES, ctrl, {0});
+    aut->new_edge(s, s, (!ctrl) & any_unctrl, {1});
+  }
+  return aut;
+}
+
+/** Time the expansion of a fixed size automaton for k uncontrollable APs.
+
+    The constructor of `hoax::HOAxParityTwA` both expands the automaton and
+    builds the arena from it, so the phases are timed by the `expand` and
+    `priority` timers of its stats, summed over all iterations.
+*/
+static void bench_expansion() {
+  for (unsigned int k = 1; k <= flag_max_unctrl; k++) {
+    const spot::twa_graph_ptr aut = expansion_automaton(k);
+    uint64_t edges = 0, eve_states = 0, runs = 0;
+    double time_expand = 0, time_arena = 0;
+    time_op([&]() {
+      hoax::HOAxParityTwA hptwa(aut, std::make_shared<hoax::CancelToken>());
+      edges = hptwa.arena.num_edges;
+      eve_states = hptwa.stats.eve_states;
+      time_expand += hptwa.stats.time_expand;
+      time_arena += hptwa.stats.time_priority;
+      runs++;
+      return size_t(hptwa.arena.num_states);
+    });
+    const double ns_expand = time_expand * 1e9 / runs;
+    const double ns_arena = time_arena * 1e9 / runs;
+    report("expansion", "k=" + std::to_string(k) + " eve_states=" + std::to_string(eve_states), ns_expand);
+    report("expansion_per_state", "k=" + std::to_string(k), ns_expand / std::max<uint64_t>(eve_states, 1));
+    report("build_arena", "k=" + std::to_string(k), ns_arena, edges);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  while (true) {
+    switch (getopt(argc, argv, "ht:n:k:")) {
+      case 't':
+        flag_min_time = atof(optarg);
+        continue;
+
+      case 'n':
+        flag_max_vertices = std::max(1000, atoi(optarg));
+        continue;
+
+      case 'k':
+        flag_max_unctrl = std::max(1, atoi(optarg));
+        continue;
+
+      case 'h': {
+        std::cout << "Usage: hoax_micro [options] [kernels]" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  -h             Show this help message and exit" << std::endl;
+        std::cout << "  -t SEC         The minimum wall time of a single measurement (default " << flag_min_time << ")" << std::endl;
+        std::cout << "  -n N           The number of vertices of the largest attractor arena (default " << flag_max_vertices << ")" << std::endl;
+        std::cout << "  -k K           The largest number of uncontrollable APs to expand (default " << flag_max_unctrl << ")" << std::endl;
+        std::cout << "Arguments:" << std::endl;
+        std::cout << "  The kernels to time: attractor, sets and/or expansion (default all)" << std::endl;
+        exit(0);
+      }
+    }
+    /* End of options. */
+    break;
+  }
+
+  std::set<std::string> kernels(argv + optind, argv + argc);
+  if (kernels.empty())
+    kernels = {"attractor", "sets", "expansion"};
+
+  if (kernels.count("attractor"))
+    bench_attractor();
+  if (kernels.count("sets"))
+    bench_sets();
+  if (kernels.count("expansion"))
+    bench_expansion();
+
+  return 0;
+}
@@ -11,25 +11,28 @@ then
     fi
 fi
 
+# The number of worker processes to solve games with, defaults to all cores.
+JOBS="${JOBS:-$(nproc)}"
+
 echo "[hoax] start at $(date +"%T")"
 # The "--brief" arg is used to run the smallest benchmark subdir, for testing.
 if [[ $* == *--brief* ]]
 then
     # Modified versions of a mucalc_mc input, to see if the tool
     # crashes and burns if it sees anything other than "marity max even".
-    time (./builddir/hoax -v -b input/hoa_benchmarks/model_paper-2.property4-*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v -b input/hoa_benchmarks/model_paper-2.property4-*.ehoa)
     # A selection of keiren and tlsf_based inputs, which are actual instances of:
     #   a) "parity min odd"  with #ACCs = 2 or 3
     #   b) "parity max even" with #ACCs = 2 or 3
-    time (./builddir/hoax -v -b input/hoa_benchmarks/diff-ACCs-*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v -b input/hoa_benchmarks/diff-ACCs-*.ehoa)
     # The entire mucalc_mc subdir of the actual benchmarks.
-    time (./builddir/hoax -v -b input/parity/parity/mucalc_mc/*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v -b input/parity/parity/mucalc_mc/*.ehoa)
 else
     # Run the entirety of the benchmarks. This requires the benchmarks to
     # be locally available at the relative path "./input/parity/parity/"
-    time (./builddir/hoax -v input/parity/parity/keiren/*.ehoa)
-    time (./builddir/hoax -v input/parity/parity/mucalc_mc/*.ehoa)
-    time (./builddir/hoax -v input/parity/parity/pgsolver_based/*.ehoa)
-    time (./builddir/hoax -v input/parity/parity/tlsf_based/*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v input/parity/parity/keiren/*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v input/parity/parity/mucalc_mc/*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v input/parity/parity/pgsolver_based/*.ehoa)
+    time (./builddir/hoax -j "$JOBS" -v input/parity/parity/tlsf_based/*.ehoa)
 fi
 echo "[hoax] finished at $(date +"%T")"
@@ -0,0 +1,227 @@
+#include "aiger.h"
+#include "hoax.h"
+#include <functional>
+#include <stdexcept>
+
+hoax::AIG::AIG(const std::vector<std::string> &input_names, const std::vector<std::string> &latch_names)
+    : input_names(input_names), latch_names(latch_names), latch_next(latch_names.size(), AIG_FALSE) {}
+
+void hoax::AIG::add_output(const unsigned int lit, const std::string &name) {
+    this->outputs.emplace_back(lit, name);
+}
+
+unsigned int hoax::AIG::make_and(unsigned int a, unsigned int b) {
+    /* Fold the trivial gates. */
+    if (a == AIG_FALSE || b == AIG_FALSE || a == (b ^ 1))
+        return AIG_FALSE;
+    if (a == AIG_TRUE || a == b)
+        return b;
+    if (b == AIG_TRUE)
+        return a;
+
+    /* AIGER orders the operands of an AND gate descending. */
+    if (a < b)
+        std::swap(a, b);
+    const uint64_t key = (uint64_t(a) << 32) | b;
+    auto it = this->and_table.find(key);
+    if (it != this->and_table.end())
+        return it->second;
+
+    const unsigned int lit = 2 * (1 + this->num_inputs() + this->num_latches() + this->num_ands());
+    this->ands.emplace_back(a, b);
+    this->and_table.emplace(key, lit);
+    return lit;
+}
+
+unsigned int hoax::AIG::make_ite(const unsigned int c, const unsigned int t, const unsigned int e) {
+    if (t == e)
+        return t;
+    if (t == AIG_TRUE && e == AIG_FALSE)
+        return c;
+    if (t == AIG_FALSE && e == AIG_TRUE)
+        return c ^ 1;
+    if (e == AIG_FALSE)
+        return this->make_and(c, t);
+    if (t == AIG_FALSE)
+        return this->make_and(c ^ 1, e);
+    if (t == AIG_TRUE)
+        return this->make_or(c, e);
+    if (e == AIG_TRUE)
+        return this->make_or(c ^ 1, t);
+    /* Create the gates in a fixed order, so the numbering does not depend
+        on the evaluation order of the arguments. */
+    const unsigned int then_lit = this->make_and(c, t);
+    const unsigned int else_lit = this->make_and(c ^ 1, e);
+    return this->make_or(then_lit, else_lit);
+}
+
+void hoax::AIG::write_aag(std::ostream &out, const std::string &comment) const {
+    const unsigned int max_var = this->num_inputs() + this->num_latches() + this->num_ands();
+    out << "aag " << max_var << " " << this->num_inputs() << " " << this->num_latches() << " "
+        << this->num_outputs() << " " << this->num_ands() << "\n";
+    for (unsigned int i = 0; i < this->num_inputs(); i++)
+        out << this->input(i) << "\n";
+    for (unsigned int i = 0; i < this->num_latches(); i++)
+        out << this->latch(i) << " " << this->latch_next[i] << "\n";
+    for (const auto &[lit, _] : this->outputs)
+        out << lit << "\n";
+    for (unsigned int i = 0; i < this->num_ands(); i++) {
+        const unsigned int lhs = 2 * (1 + this->num_inputs() + this->num_latches() + i);
+        out << lhs << " " << this->ands[i].first << " " << this->ands[i].second << "\n";
+    }
+
+    /* The symbol table. */
+    for (unsigned int i = 0; i < this->num_inputs(); i++)
+        out << "i" << i << " " << this->input_names[i] << "\n";
+    for (unsigned int i = 0; i < this->num_latches(); i++)
+        out << "l" << i << " " << this->latch_names[i] << "\n";
+    for (unsigned int i = 0; i < this->num_outputs(); i++)
+        out << "o" << i << " " << this->outputs[i].second << "\n";
+
+    if (!comment.empty())
+        out << "c\n" << comment << "\n";
+}
+
+hoax::AIG hoax::synthesize_controller(const hoax::HOAxParityTwA &aut) {
+    if (aut.src == nullptr || aut.exp == nullptr)
+        throw std::runtime_error("Controller synthesis requires the expanded TwA");
+    if (aut.strategy.size() != aut.arena.num_states)
+        throw std::runtime_error("Controller synthesis requires a solved game");
+
+    const unsigned int init_state = aut.arena.init_state;
+    auto winners = aut.exp->get_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER);
+    if (winners == nullptr || winners->at(init_state) != PEVEN)
+        throw std::runtime_error("Eve does not win the initial state, so there is no controller");
+
+    /* Collect the source states that are reachable under Eve's strategy.
+        Every source state has a code, which is its latch state, and the
+        initial state gets the all zero code. */
+    std::vector<int> code(aut.src->num_states(), -1);
+    std::vector<unsigned int> reachable = {init_state};
+    code[init_state] = 0;
+    for (size_t i = 0; i < reachable.size(); i++) {
+        aut.assert_deadline();
+        for (auto &edge : aut.exp->out(reachable[i])) {
+            const int dst = aut.eve_move(edge.dst);
+            if (dst < 0)
+                throw std::runtime_error("Eve has no strategy in a reachable state");
+            if (code[dst] < 0) {
+                code[dst] = reachable.size();
+                reachable.push_back(dst);
+            }
+        }
+    }
+    unsigned int num_latches = 0;
+    while ((size_t(1) << num_latches) < reachable.size())
+        num_latches++;
+
+    /* Use fresh BDD variables for the latches, for as long as this call runs. */
+    const spot::bdd_dict_ptr dict = aut.src->get_dict();
+    struct LatchVars {
+        spot::bdd_dict_ptr dict;
+        int first = 0;
+        ~LatchVars() { dict->unregister_all_my_variables(this); }
+    } latch_vars{dict};
+    if (num_latches > 0)
+        latch_vars.first = dict->register_anonymous_variables(num_latches, &latch_vars);
+
+    auto encode = [&latch_vars, num_latches](const unsigned int c) {
+        bdd cube = bddtrue;
+        for (unsigned int b = 0; b < num_latches; b++)
+            cube &= ((c >> b) & 1) ? bdd_ithvar(latch_vars.first + b) : bdd_nithvar(latch_vars.first + b);
+        return cube;
+    };
+
+    /* Split the APs into inputs (uncontrollable) and outputs (controllable). */
+    const bdd controllable = spot::get_synthesis_outputs(aut.src);
+    std::vector<std::string> input_names, latch_names, output_names;
+    std::vector<int> input_vars, output_vars;
+    for (const spot::formula &ap : aut.src->ap()) {
+        const int var = dict->varnum(ap);
+        const bool is_output = (controllable & bdd_ithvar(var)) == controllable;
+        (is_output ? output_names : input_names).push_back(ap.ap_name());
+        (is_output ? output_vars : input_vars).push_back(var);
+    }
+    for (unsigned int b = 0; b < num_latches; b++)
+        latch_names.push_back("state_" + std::to_string(b));
+
+    /* Build the strategy relation over (latches, inputs, outputs), the care
+        set over (latches, inputs), and the next latch states.
+
+        For every reachable state and uncontrollable evaluation, i.e. every
+        "even player" state, Eve moves to a single successor, along the
+        edges that her strategy allows. Every controllable evaluation of
+        those edges is allowed. */
+    bdd relation = bddfalse;
+    bdd care = bddfalse;
+    std::vector<bdd> next(num_latches, bddfalse);
+    for (const unsigned int state : reachable) {
+        aut.assert_deadline();
+        const bdd enc = encode(code[state]);
+        for (auto &edge : aut.exp->out(state)) {
+            const int dst = aut.eve_move(edge.dst);
+            bdd moves = bddfalse;
+            for (auto &move : aut.exp->out(edge.dst))
+                if (aut.eve_allows(aut.exp->edge_number(move)))
+                    moves |= move.cond;
+
+            const bdd pre = enc & edge.cond;
+            care |= pre;
+            relation |= pre & moves;
+            for (unsigned int b = 0; b < num_latches; b++)
+                if ((code[dst] >> b) & 1)
+                    next[b] |= pre;
+        }
+    }
+
+    /* Determinize the outputs one by one. An output must be 1 where only
+        1 is allowed, must be 0 where only 0 is allowed, and is free
+        everywhere else. Substituting the chosen function keeps the other
+        outputs consistent with it. */
+    std::vector<bdd> functions;
+    for (size_t o = 0; o < output_vars.size(); o++) {
+        bdd later = bddtrue;
+        for (size_t p = o + 1; p < output_vars.size(); p++)
+            later &= bdd_ithvar(output_vars[p]);
+
+        const bdd can_be_1 = bdd_exist(bdd_restrict(relation, bdd_ithvar(output_vars[o])), later);
+        const bdd can_be_0 = bdd_exist(bdd_restrict(relation, bdd_nithvar(output_vars[o])), later);
+        const bdd must_be_1 = can_be_1 & !can_be_0;
+        const bdd must_be_0 = can_be_0 & !can_be_1;
+        const bdd function = bdd_simplify(must_be_1, must_be_1 | must_be_0);
+        relation = bdd_compose(relation, function, output_vars[o]);
+        functions.push_back(function);
+    }
+    for (unsigned int b = 0; b < num_latches; b++)
+        next[b] = bdd_simplify(next[b], care);
+
+    /* Convert the BDDs to AND gates; a BDD node is a multiplexer. */
+    hoax::AIG aig(input_names, latch_names);
+    std::unordered_map<int, unsigned int> var_lits;
+    for (size_t i = 0; i < input_vars.size(); i++)
+        var_lits[input_vars[i]] = aig.input(i);
+    for (unsigned int b = 0; b < num_latches; b++)
+        var_lits[latch_vars.first + b] = aig.latch(b);
+
+    std::unordered_map<int, unsigned int> node_lits;
+    std::function<unsigned int(const bdd&)> to_lit = [&](const bdd &f) -> unsigned int {
+        if (f == bddtrue)
+            return AIG_TRUE;
+        if (f == bddfalse)
+            return AIG_FALSE;
+        auto it = node_lits.find(f.id());
+        if (it != node_lits.end())
+            return it->second;
+        const unsigned int high = to_lit(bdd_high(f));
+        const unsigned int low = to_lit(bdd_low(f));
+        const unsigned int lit = aig.make_ite(var_lits.at(bdd_var(f)), high, low);
+        node_lits.emplace(f.id(), lit);
+        return lit;
+    };
+
+    for (unsigned int b = 0; b < num_latches; b++)
+        aig.set_latch_next(b, to_lit(next[b]));
+    for (size_t o = 0; o < output_vars.size(); o++)
+        aig.add_output(to_lit(functions[o]), output_names[o]);
+    return aig;
+}
@@ -0,0 +1,105 @@
+#ifndef HOAX_AIGER_H
+#define HOAX_AIGER_H
+
+#include <unordered_map>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <string>
+#include <vector>
+
+namespace hoax {
+
+    struct HOAxParityTwA;
+
+    /** The literal of the constant false in an And-Inverter Graph. */
+    #define AIG_FALSE 0
+    /** The literal of the constant true in an And-Inverter Graph. */
+    #define AIG_TRUE 1
+
+    /** An And-Inverter Graph (AIG) with latches, as used by the AIGER format.
+
+        A literal is twice a variable index, plus one iff. it is negated.
+        Variable 0 is the constant false, then come the inputs, then the
+        latches, and then the AND gates. So all inputs and latches must be
+        declared up front, by the constructor.
+
+        AND gates are structurally hashed: requesting the same AND gate twice
+        returns the same literal, and trivial gates are folded away, e.g.
+        `x & !x` is `AIG_FALSE`.
+    */
+    class AIG {
+    public:
+        /** @param[in] input_names The name of every input
+            @param[in] latch_names The name of every latch
+        */
+        AIG(const std::vector<std::string> &input_names, const std::vector<std::string> &latch_names);
+
+        /** Get the literal of the i'th input. */
+        unsigned int input(const unsigned int i) const { return 2 * (1 + i); }
+
+        /** Get the literal of the i'th latch. */
+        unsigned int latch(const unsigned int i) const { return 2 * (1 + this->input_names.size() + i); }
+
+        /** Set the next state function of the i'th latch; every latch is initially 0. */
+        void set_latch_next(const unsigned int i, const unsigned int next) { this->latch_next.at(i) = next; }
+
+        /** Add an output. */
+        void add_output(const unsigned int lit, const std::string &name);
+
+        /** Get the literal of the conjunction of two literals. */
+        unsigned int make_and(unsigned int a, unsigned int b);
+
+        /** Get the literal of the disjunction of two literals. */
+        unsigned int make_or(const unsigned int a, const unsigned int b) { return this->make_and(a ^ 1, b ^ 1) ^ 1; }
+
+        /** Get the literal of "if c then t else e". */
+        unsigned int make_ite(const unsigned int c, const unsigned int t, const unsigned int e);
+
+        unsigned int num_inputs() const { return this->input_names.size(); }
+        unsigned int num_latches() const { return this->latch_names.size(); }
+        unsigned int num_outputs() const { return this->outputs.size(); }
+        unsigned int num_ands() const { return this->ands.size(); }
+
+        /** Write the AIG in the ASCII AIGER format, including a symbol table.
+
+            @param[out] out The stream to write to
+            @param[in] comment An optional comment, which may span lines
+        */
+        void write_aag(std::ostream &out, const std::string &comment = "") const;
+
+    private:
+        std::vector<std::string> input_names;
+        std::vector<std::string> latch_names;
+        std::vector<unsigned int> latch_next;
+        std::vector<std::pair<unsigned int, std::string>> outputs;
+        /** The two operand literals of every AND gate, in creation order. */
+        std::vector<std::pair<unsigned int, unsigned int>> ands;
+        /** The structural hash table, from operand literals to AND literal. */
+        std::unordered_map<uint64_t, unsigned int> and_table;
+    };
+
+    /** Build a controller circuit from Eve's winning strategy.
+
+        The strategy recorded by `HOAxParityTwA::solve_parity_game` is
+        projected back onto the source automaton: the latches encode the
+        source state, the inputs are the uncontrollable APs and the outputs
+        are the controllable APs. To keep the circuit small:
+
+        1) Only the source states reachable under the strategy are encoded,
+           in binary, with the initial state as the all zero latch state.
+        2) The outputs are determinized one by one, and simplified with
+           `bdd_simplify` using every don't care: unreachable latch states,
+           input evaluations without any move, and all output values that
+           the strategy allows.
+        3) The BDDs are converted to AND gates with structural hashing.
+
+        @pre The game was solved, and Eve wins from the initial state.
+        @pre The expanded TwA is available, i.e. the arena was not cached.
+        @param[in] aut The solved parity game
+        @return The controller circuit
+    */
+    AIG synthesize_controller(const HOAxParityTwA &aut);
+}
+
+#endif
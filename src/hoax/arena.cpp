@@ -0,0 +1,296 @@
+#include "arena.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+    /** The magic bytes at the start of every arena cache file. */
+    const char ARENA_MAGIC[8] = {'H', 'O', 'A', 'X', 'A', 'R', 'N', '\0'};
+    /** Bump this whenever the binary layout changes. */
+    const uint32_t ARENA_VERSION = 3;
+
+    /** The fixed size header of an arena cache file.
+
+        Every array section is stored at an 8 byte aligned offset from the
+        start of the file, so it can be used in-place after `mmap`.
+    */
+    struct ArenaHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t source_hash;
+        uint32_t num_states;
+        uint32_t num_edges;
+        uint32_t init_state;
+        uint32_t num_sets;
+        uint32_t num_priorities;
+        uint32_t priority_width;
+        uint64_t off_offsets;
+        uint64_t off_targets;
+        uint64_t off_owners;
+        uint64_t off_priority_table;
+        uint64_t off_priority_codes;
+        uint64_t file_size;
+    };
+
+    const uint32_t FLAG_PARITY_MAX = 1 << 0;
+    const uint32_t FLAG_PARITY_ODD = 1 << 1;
+
+    const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    const uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+    /** Extend a FNV-1a hash with the given bytes. */
+    uint64_t fnv1a(uint64_t hash, const char *data, const size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /** Round up to the next multiple of 8. */
+    uint64_t align8(const uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+    /** The heap storage backing a `hoax::make_arena` arena. */
+    struct ArenaBuffers {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> targets;
+        std::vector<uint64_t> owners;
+        std::vector<int32_t> priority_table;
+        std::vector<uint8_t> priority_codes;
+    };
+
+    /** The mmap storage backing a `hoax::map_arena` arena. */
+    struct ArenaMapping {
+        void *addr;
+        size_t size;
+        ArenaMapping(void *addr, const size_t size) : addr(addr), size(size) {}
+        ArenaMapping(const ArenaMapping&) = delete;
+        ArenaMapping &operator=(const ArenaMapping&) = delete;
+        ~ArenaMapping() { munmap(addr, size); }
+    };
+}
+
+hoax::Arena hoax::make_arena(std::vector<uint32_t> &&offsets, std::vector<uint32_t> &&targets,
+                             const std::vector<bool> &owners, const std::vector<int> &priorities,
+                             const unsigned int init_state, const bool parity_max,
+                             const bool parity_odd, const unsigned int num_sets) {
+    const unsigned int num_states = offsets.size() - 1;
+    assert(offsets.size() >= 1);
+    assert(owners.size() == num_states);
+    assert(priorities.size() == num_states);
+    assert(offsets.back() == targets.size());
+
+    auto buffers = std::make_shared<ArenaBuffers>();
+    buffers->offsets = std::move(offsets);
+    buffers->targets = std::move(targets);
+
+    /* Pack the owners into a bitvector. */
+    buffers->owners.resize((num_states + 63) / 64, 0);
+    for (unsigned int state = 0; state < num_states; state++)
+        if (owners[state])
+            buffers->owners[state >> 6] |= uint64_t(1) << (state & 63);
+
+    /* Compress the priorities into a table of distinct values. */
+    buffers->priority_table.assign(priorities.begin(), priorities.end());
+    std::sort(buffers->priority_table.begin(), buffers->priority_table.end());
+    buffers->priority_table.erase(std::unique(buffers->priority_table.begin(), buffers->priority_table.end()),
+                                  buffers->priority_table.end());
+
+    const size_t num_priorities = buffers->priority_table.size();
+    const unsigned int width = num_priorities <= 0x100 ? 1 : num_priorities <= 0x10000 ? 2 : 4;
+    buffers->priority_codes.resize(size_t(num_states) * width);
+    for (unsigned int state = 0; state < num_states; state++) {
+        const uint32_t code = std::lower_bound(buffers->priority_table.begin(),
+                                               buffers->priority_table.end(),
+                                               priorities[state]) - buffers->priority_table.begin();
+        uint8_t *codes = buffers->priority_codes.data();
+        switch (width) {
+            case 1:  reinterpret_cast<uint8_t*>(codes)[state] = code; break;
+            case 2:  reinterpret_cast<uint16_t*>(codes)[state] = code; break;
+            default: reinterpret_cast<uint32_t*>(codes)[state] = code; break;
+        }
+    }
+
+    hoax::Arena arena;
+    arena.num_states = num_states;
+    arena.num_edges = buffers->targets.size();
+    arena.init_state = init_state;
+    arena.parity_max = parity_max;
+    arena.parity_odd = parity_odd;
+    arena.num_sets = num_sets;
+    arena.offsets = buffers->offsets.data();
+    arena.targets = buffers->targets.data();
+    arena.owners = buffers->owners.data();
+    arena.priority_table = buffers->priority_table.data();
+    arena.num_priorities = num_priorities;
+    arena.priority_codes = buffers->priority_codes.data();
+    arena.priority_width = width;
+    arena.storage = buffers;
+    return arena;
+}
+
+uint64_t hoax::file_hash(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        throw std::runtime_error("Could not open ifstream to hash " + path.string());
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    char buffer[1 << 16];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        hash = fnv1a(hash, buffer, in.gcount());
+    }
+    return hash;
+}
+
+uint64_t hoax::data_hash(const char *data, const size_t size) {
+    return fnv1a(FNV_OFFSET_BASIS, data, size);
+}
+
+std::filesystem::path hoax::arena_cache_path(const std::filesystem::path &dir_cache,
+                                             const std::filesystem::path &path_in) {
+    /* Benchmark trees hold many inputs with the same name, so key the entry
+        on the whole path, but keep the name for readability. */
+    const std::string path = std::filesystem::absolute(path_in).lexically_normal().generic_string();
+    std::ostringstream name;
+    name << path_in.filename().string() << "." << std::hex << std::setw(16) << std::setfill('0')
+         << hoax::data_hash(path.data(), path.size()) << ARENA_CACHE_EXT;
+    return dir_cache / name.str();
+}
+
+void hoax::write_arena(const std::filesystem::path &path, const hoax::Arena &arena,
+                       const uint64_t source_hash) {
+    const uint64_t owners_size = ((arena.num_states + 63) / 64) * sizeof(uint64_t);
+
+    ArenaHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ARENA_MAGIC, sizeof(ARENA_MAGIC));
+    header.version = ARENA_VERSION;
+    header.flags = (arena.parity_max ? FLAG_PARITY_MAX : 0) | (arena.parity_odd ? FLAG_PARITY_ODD : 0);
+    header.source_hash = source_hash;
+    header.num_states = arena.num_states;
+    header.num_edges = arena.num_edges;
+    header.init_state = arena.init_state;
+    header.num_sets = arena.num_sets;
+    header.num_priorities = arena.num_priorities;
+    header.priority_width = arena.priority_width;
+    header.off_offsets = align8(sizeof(ArenaHeader));
+    header.off_targets = align8(header.off_offsets + (uint64_t(arena.num_states) + 1) * sizeof(uint32_t));
+    header.off_owners = align8(header.off_targets + uint64_t(arena.num_edges) * sizeof(uint32_t));
+    header.off_priority_table = align8(header.off_owners + owners_size);
+    header.off_priority_codes = align8(header.off_priority_table + uint64_t(arena.num_priorities) * sizeof(int32_t));
+    header.file_size = align8(header.off_priority_codes + uint64_t(arena.num_states) * arena.priority_width);
+
+    std::filesystem::create_directories(path.parent_path());
+    const std::filesystem::path path_tmp = path.string() + ".tmp" + std::to_string(getpid());
+    std::ofstream out(path_tmp, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        throw std::runtime_error("Could not open ofstream to write arena cache " + path_tmp.string());
+
+    /* Write a section, zero padded up to its offset. */
+    auto write_at = [&out](const uint64_t offset, const void *data, const uint64_t size) {
+        static const char zeros[8] = {0};
+        const uint64_t pos = out.tellp();
+        out.write(zeros, offset - pos);
+        out.write(static_cast<const char*>(data), size);
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_at(header.off_offsets, arena.offsets, (uint64_t(arena.num_states) + 1) * sizeof(uint32_t));
+    write_at(header.off_targets, arena.targets, uint64_t(arena.num_edges) * sizeof(uint32_t));
+    write_at(header.off_owners, arena.owners, owners_size);
+    write_at(header.off_priority_table, arena.priority_table, uint64_t(arena.num_priorities) * sizeof(int32_t));
+    write_at(header.off_priority_codes, arena.priority_codes, uint64_t(arena.num_states) * arena.priority_width);
+    write_at(header.file_size, nullptr, 0);
+    out.close();
+    if (!out)
+        throw std::runtime_error("Could not write arena cache " + path_tmp.string());
+
+    std::filesystem::rename(path_tmp, path);
+}
+
+std::optional<hoax::Arena> hoax::map_arena(const std::filesystem::path &path,
+                                           const uint64_t source_hash) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return std::nullopt;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(ArenaHeader)) {
+        close(fd);
+        return std::nullopt;
+    }
+
+    /* The mapping stays valid after closing the file descriptor. */
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return std::nullopt;
+    auto mapping = std::make_shared<ArenaMapping>(addr, size_t(st.st_size));
+
+    /* Validate the header before trusting any of the offsets in it. */
+    const ArenaHeader *header = static_cast<const ArenaHeader*>(addr);
+    const char *base = static_cast<const char*>(addr);
+    if (std::memcmp(header->magic, ARENA_MAGIC, sizeof(ARENA_MAGIC)) != 0 ||
+        header->version != ARENA_VERSION ||
+        header->source_hash != source_hash ||
+        header->file_size != uint64_t(st.st_size) ||
+        !(header->priority_width == 1 || header->priority_width == 2 || header->priority_width == 4))
+        return std::nullopt;
+
+    /* Every section must be aligned and lie within the file. The offsets are
+        read from disk, so they are checked one by one instead of trusting
+        their order. */
+    const uint64_t num_states = header->num_states;
+    const uint64_t owners_size = ((num_states + 63) / 64) * sizeof(uint64_t);
+    auto in_file = [header](const uint64_t offset, const uint64_t size) {
+        return offset % 8 == 0 && offset >= sizeof(ArenaHeader) &&
+            offset <= header->file_size && size <= header->file_size - offset;
+    };
+    if (!in_file(header->off_offsets, (num_states + 1) * sizeof(uint32_t)) ||
+        !in_file(header->off_targets, uint64_t(header->num_edges) * sizeof(uint32_t)) ||
+        !in_file(header->off_owners, owners_size) ||
+        !in_file(header->off_priority_table, uint64_t(header->num_priorities) * sizeof(int32_t)) ||
+        !in_file(header->off_priority_codes, num_states * header->priority_width))
+        return std::nullopt;
+
+    hoax::Arena arena;
+    arena.num_states = header->num_states;
+    arena.num_edges = header->num_edges;
+    arena.init_state = header->init_state;
+    arena.parity_max = header->flags & FLAG_PARITY_MAX;
+    arena.parity_odd = header->flags & FLAG_PARITY_ODD;
+    arena.num_sets = header->num_sets;
+    arena.offsets = reinterpret_cast<const uint32_t*>(base + header->off_offsets);
+    arena.targets = reinterpret_cast<const uint32_t*>(base + header->off_targets);
+    arena.owners = reinterpret_cast<const uint64_t*>(base + header->off_owners);
+    arena.priority_table = reinterpret_cast<const int32_t*>(base + header->off_priority_table);
+    arena.num_priorities = header->num_priorities;
+    arena.priority_codes = base + header->off_priority_codes;
+    arena.priority_width = header->priority_width;
+    arena.storage = mapping;
+
+    /* Check the invariants the solvers rely on, so a corrupt file is a cache
+        miss instead of an out of bounds access. */
+    if (arena.init_state >= arena.num_states ||
+        arena.offsets[0] != 0 || arena.offsets[arena.num_states] != arena.num_edges)
+        return std::nullopt;
+    for (unsigned int state = 0; state < arena.num_states; state++)
+        if (arena.offsets[state] > arena.offsets[state + 1])
+            return std::nullopt;
+    for (unsigned int edge = 0; edge < arena.num_edges; edge++)
+        if (arena.targets[edge] >= arena.num_states)
+            return std::nullopt;
+    for (unsigned int state = 0; state < arena.num_states; state++)
+        if (arena.priority_code(state) >= arena.num_priorities)
+            return std::nullopt;
+    return arena;
+}
@@ -0,0 +1,162 @@
+#ifndef HOAX_ARENA_H
+#define HOAX_ARENA_H
+
+#include <filesystem>
+#include <optional>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hoax {
+
+    /** The file extension of a serialized (cached) parity arena. */
+    #define ARENA_CACHE_EXT ".hoaxa"
+
+    /** A compact, read-only parity game arena.
+
+        The successors of every vertex are stored in CSR (compressed sparse
+        row) form: the successors of vertex `v` are the entries
+        `targets[offsets[v]]` up to, but excluding, `targets[offsets[v+1]]`.
+
+        The owner of every vertex is stored as a single bit, where a set bit
+        means the "odd player" (Adam) owns the vertex.
+
+        Priorities are compressed: every distinct priority is stored once in
+        a sorted table, and every vertex only stores a 1, 2 or 4 byte index
+        into that table, depending on the number of distinct priorities.
+
+        The arena does not own its arrays directly; the `storage` handle keeps
+        them alive. This allows the arrays to either live in heap memory, or
+        directly inside of a memory mapped cache file, without any copies.
+    */
+    struct Arena {
+        /** A contiguous range of successor vertices. */
+        struct Successors {
+            const uint32_t *first;
+            const uint32_t *last;
+            const uint32_t *begin() const { return first; }
+            const uint32_t *end() const { return last; }
+            size_t size() const { return last - first; }
+        };
+
+        /** The number of vertices in the arena. */
+        unsigned int num_states = 0;
+        /** The number of edges in the arena. */
+        unsigned int num_edges = 0;
+        /** The initial vertex of the arena. */
+        unsigned int init_state = 0;
+
+        /** If true, then the arena uses the "parity max" condition. */
+        bool parity_max = true;
+        /** If true, then the arena uses the "parity odd" condition. */
+        bool parity_odd = false;
+        /** The number of acceptance sets of the source automaton. */
+        unsigned int num_sets = 0;
+
+        /** The CSR row offsets, of size `num_states + 1`. */
+        const uint32_t *offsets = nullptr;
+        /** The CSR successor array, of size `num_edges`. */
+        const uint32_t *targets = nullptr;
+        /** The owner bitvector, of size `ceil(num_states / 64)`. */
+        const uint64_t *owners = nullptr;
+
+        /** The sorted table of all distinct priorities. */
+        const int32_t *priority_table = nullptr;
+        /** The number of entries in the priority table. */
+        unsigned int num_priorities = 0;
+        /** Per vertex index into the priority table. */
+        const void *priority_codes = nullptr;
+        /** The size in bytes of a single priority index: 1, 2 or 4. */
+        unsigned int priority_width = 0;
+
+        /** Keeps the memory backing the above arrays alive. */
+        std::shared_ptr<const void> storage;
+
+        /** Get the successors of the given vertex. */
+        Successors successors(const unsigned int state) const {
+            return {targets + offsets[state], targets + offsets[state + 1]};
+        }
+
+        /** Get the owner of the given vertex, true iff. the "odd player". */
+        bool owner(const unsigned int state) const {
+            return (owners[state >> 6] >> (state & 63)) & 1;
+        }
+
+        /** Get the index of the given vertex's priority in the priority table.
+
+            The table is sorted, so comparing indexes is comparing priorities.
+        */
+        uint32_t priority_code(const unsigned int state) const {
+            switch (priority_width) {
+                case 1:  return static_cast<const uint8_t*>(priority_codes)[state];
+                case 2:  return static_cast<const uint16_t*>(priority_codes)[state];
+                default: return static_cast<const uint32_t*>(priority_codes)[state];
+            }
+        }
+
+        /** Get the (decompressed) priority of the given vertex. */
+        int priority(const unsigned int state) const {
+            return priority_table[priority_code(state)];
+        }
+    };
+
+    /** Build an arena that owns its (heap allocated) arrays.
+
+        @param[in] offsets The CSR row offsets, of size `#vertices + 1`
+        @param[in] targets The CSR successor array
+        @param[in] owners The owner of every vertex, true iff. the "odd player"
+        @param[in] priorities The priority of every vertex
+        @param[in] init_state The initial vertex
+        @param[in] parity_max If true, then the arena is "parity max"
+        @param[in] parity_odd If true, then the arena is "parity odd"
+        @param[in] num_sets The number of acceptance sets
+        @return The compressed arena
+    */
+    Arena make_arena(std::vector<uint32_t> &&offsets, std::vector<uint32_t> &&targets,
+                     const std::vector<bool> &owners, const std::vector<int> &priorities,
+                     const unsigned int init_state, const bool parity_max,
+                     const bool parity_odd, const unsigned int num_sets);
+
+    /** Compute the 64 bit FNV-1a hash of the contents of a file.
+
+        This is used to invalidate cached arenas when their source file changes.
+    */
+    uint64_t file_hash(const std::filesystem::path &path);
+
+    /** Compute the `hoax::file_hash` of a file content that is already in memory. */
+    uint64_t data_hash(const char *data, const size_t size);
+
+    /** Get the cache file path for the given input file.
+
+        The name of the cache file holds the name of the input file and a
+        hash of its absolute path, so that inputs with the same name in
+        different directories do not share a cache file.
+    */
+    std::filesystem::path arena_cache_path(const std::filesystem::path &dir_cache,
+                                           const std::filesystem::path &path_in);
+
+    /** Serialize the arena to a binary cache file.
+
+        The file is first written to a temporary path and then renamed, so
+        concurrent readers never observe a partially written cache file.
+
+        @param[in] path The path of the cache file to write
+        @param[in] arena The arena to serialize
+        @param[in] source_hash The `hoax::file_hash` of the arena's source file
+    */
+    void write_arena(const std::filesystem::path &path, const Arena &arena,
+                     const uint64_t source_hash);
+
+    /** Memory map a binary cache file as an arena, without copying.
+
+        @param[in] path The path of the cache file to map
+        @param[in] source_hash The `hoax::file_hash` of the arena's source file
+        @return The mapped arena, or no value if the cache file is missing,
+                malformed (truncated, or with sections, edges or priorities
+                out of bounds) or was created from a different source file content.
+    */
+    std::optional<Arena> map_arena(const std::filesystem::path &path,
+                                   const uint64_t source_hash);
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "batch.h"
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+    /** The bookkeeping of a running child process. */
+    struct Worker {
+        pid_t pid;
+        int fd;
+        size_t job;
+    };
+}
+
+void hoax::run_batch(const size_t num_jobs, const unsigned int num_workers,
+                     const std::function<void(size_t)> &job,
+                     const std::function<void(size_t, const hoax::BatchResult&)> &on_done) {
+    std::vector<hoax::BatchResult> results(num_jobs);
+    std::vector<bool> done(num_jobs, false);
+    std::vector<Worker> workers;
+    size_t next_job = 0;
+    size_t next_report = 0;
+
+    while (next_report < num_jobs) {
+        /* Hand out jobs to free workers. */
+        while (workers.size() < num_workers && next_job < num_jobs) {
+            int fds[2];
+            if (pipe(fds) != 0)
+                throw std::runtime_error(std::string("Could not create batch pipe: ") + strerror(errno));
+
+            const pid_t pid = fork();
+            if (pid < 0)
+                throw std::runtime_error(std::string("Could not fork batch worker: ") + strerror(errno));
+
+            if (pid == 0) {
+                /* Child: redirect stdout into the pipe and run the job. */
+                close(fds[0]);
+                for (const auto &worker : workers)
+                    close(worker.fd);
+                dup2(fds[1], STDOUT_FILENO);
+                close(fds[1]);
+
+                int ret = 0;
+                try {
+                    job(next_job);
+                } catch (std::exception &e) {
+                    std::cerr << e.what() << std::endl;
+                    ret = 1;
+                }
+                std::cout.flush();
+                fflush(stdout);
+                /* Skip the parent's atexit handlers and static destructors. */
+                _exit(ret);
+            }
+
+            close(fds[1]);
+            workers.push_back({pid, fds[0], next_job++});
+        }
+
+        /* Wait for output of, or the end of, any running job. */
+        std::vector<struct pollfd> pfds(workers.size());
+        for (size_t i = 0; i < workers.size(); i++)
+            pfds[i] = {workers[i].fd, POLLIN, 0};
+        if (poll(pfds.data(), pfds.size(), -1) < 0 && errno != EINTR)
+            throw std::runtime_error(std::string("Could not poll batch workers: ") + strerror(errno));
+
+        for (size_t i = pfds.size(); i-- > 0;) {
+            if (pfds[i].revents == 0)
+                continue;
+
+            Worker &worker = workers[i];
+            char buffer[4096];
+            const ssize_t count = read(worker.fd, buffer, sizeof(buffer));
+            if (count > 0) {
+                results[worker.job].output.append(buffer, count);
+                continue;
+            }
+            if (count < 0 && errno == EINTR)
+                continue;
+
+            /* EOF: the child closed its stdout, so reap it. */
+            close(worker.fd);
+            hoax::BatchResult &result = results[worker.job];
+            while (wait4(worker.pid, &result.status, 0, &result.usage) < 0 && errno == EINTR);
+            done[worker.job] = true;
+            workers.erase(workers.begin() + i);
+        }
+
+        /* Report finished jobs in order. */
+        while (next_report < num_jobs && done[next_report]) {
+            on_done(next_report, results[next_report]);
+            results[next_report].output.clear();
+            results[next_report].output.shrink_to_fit();
+            next_report++;
+        }
+        std::cout.flush();
+    }
+}
+
+std::string hoax::describe_status(const int status) {
+    if (WIFEXITED(status))
+        return "exit " + std::to_string(WEXITSTATUS(status));
+    if (WIFSIGNALED(status))
+        return "signal " + std::to_string(WTERMSIG(status));
+    return "status " + std::to_string(status);
+}
@@ -0,0 +1,48 @@
+#ifndef HOAX_BATCH_H
+#define HOAX_BATCH_H
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <functional>
+#include <string>
+
+namespace hoax {
+
+    /** The outcome of a single job run by `hoax::run_batch`. */
+    struct BatchResult {
+        /** The wait status of the job's process, see `waitpid`. */
+        int status = 0;
+        /** The resource usage of the job's process, e.g. its peak RSS. */
+        struct rusage usage = {};
+        /** Everything the job wrote to stdout. */
+        std::string output;
+    };
+
+    /** Run jobs in isolated child processes, with a bounded number of workers.
+
+        Every job runs in a freshly forked process, so global state such as
+        the BuDDy node table is never shared between jobs, and a job that
+        crashes or is killed for running out of memory does not take the
+        other jobs down with it. The jobs are handed out in index order to
+        the first free worker, i.e. the workers pull from a shared queue.
+
+        The stdout of each job is captured. The `on_done` callback is called
+        in the parent process in job index order, regardless of the order in
+        which the jobs finish, so output stays stable across runs.
+
+        @pre Pending stdout buffers must be flushed before calling this,
+             or else every child process flushes a copy of them.
+        @param[in] num_jobs The number of jobs, indexed [0, num_jobs)
+        @param[in] num_workers The maximum number of concurrent processes
+        @param[in] job The job to run in a child process, given its index
+        @param[in] on_done The callback to report the result of a job
+    */
+    void run_batch(const size_t num_jobs, const unsigned int num_workers,
+                   const std::function<void(size_t)> &job,
+                   const std::function<void(size_t, const BatchResult&)> &on_done);
+
+    /** Describe a `waitpid` status, e.g. "exit 1" or "signal 9". */
+    std::string describe_status(const int status);
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "cancel.h"
+#include <stdexcept>
+#include <string>
+
+hoax::CancelToken::CancelToken(const budget_clock::duration budget, const budget_clock::time_point start)
+    : start(start), budget(budget), reason(NONE) {}
+
+void hoax::CancelToken::cancel(const Reason why) {
+    int expected = NONE;
+    this->reason.compare_exchange_strong(expected, why, std::memory_order_relaxed);
+}
+
+double hoax::CancelToken::elapsed() const {
+    return std::chrono::duration<double>(budget_clock::now() - this->start).count();
+}
+
+void hoax::CancelToken::raise() const {
+    const std::string sruntime = std::to_string(this->elapsed());
+    switch (this->reason.load(std::memory_order_relaxed)) {
+        case GAME_BUDGET: {
+            const std::string sruntime_max = std::to_string(std::chrono::duration<double>(this->budget).count());
+            throw std::runtime_error("Runtime (" + sruntime + "s) exceeds max runtime (" + sruntime_max + "s).");
+        }
+        case BATCH_BUDGET:
+            throw std::runtime_error("Runtime (" + sruntime + "s) exceeds the batch budget.");
+        default:
+            throw std::runtime_error("Cancelled after " + sruntime + "s.");
+    }
+}
+
+hoax::Watchdog::Watchdog() : thread(&hoax::Watchdog::run, this) {}
+
+hoax::Watchdog::~Watchdog() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->wakeup.notify_all();
+    this->thread.join();
+}
+
+std::shared_ptr<hoax::CancelToken> hoax::Watchdog::arm(const budget_clock::duration budget,
+                                                      const budget_clock::duration spent) {
+    auto token = std::make_shared<hoax::CancelToken>(budget, budget_clock::now() - spent);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->batch_expired) {
+            token->cancel(hoax::CancelToken::BATCH_BUDGET);
+            return token;
+        }
+
+        /* Drop the entries of tokens that were already destroyed. */
+        for (auto it = this->deadlines.begin(); it != this->deadlines.end();)
+            it = it->second.expired() ? this->deadlines.erase(it) : std::next(it);
+
+        /* Saturate, a "max" budget must not overflow the time point. */
+        const budget_clock::time_point deadline =
+            (budget >= budget_clock::time_point::max() - token->start) ?
+                budget_clock::time_point::max() : token->start + budget;
+        this->deadlines.emplace(deadline, token);
+    }
+    this->wakeup.notify_all();
+    return token;
+}
+
+void hoax::Watchdog::set_batch_deadline(const budget_clock::time_point deadline) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->batch_deadline = deadline;
+    }
+    this->wakeup.notify_all();
+}
+
+void hoax::Watchdog::run() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (!this->stopping) {
+        const budget_clock::time_point now = budget_clock::now();
+
+        if (!this->batch_expired && now >= this->batch_deadline) {
+            this->batch_expired = true;
+            for (auto &entry : this->deadlines)
+                if (auto token = entry.second.lock())
+                    token->cancel(hoax::CancelToken::BATCH_BUDGET);
+            this->deadlines.clear();
+        }
+
+        /* Cancel every token whose deadline passed. */
+        while (!this->deadlines.empty() && this->deadlines.begin()->first <= now) {
+            if (auto token = this->deadlines.begin()->second.lock())
+                token->cancel(hoax::CancelToken::GAME_BUDGET);
+            this->deadlines.erase(this->deadlines.begin());
+        }
+
+        budget_clock::time_point next = this->batch_expired ? budget_clock::time_point::max() : this->batch_deadline;
+        if (!this->deadlines.empty())
+            next = std::min(next, this->deadlines.begin()->first);
+
+        if (next == budget_clock::time_point::max())
+            this->wakeup.wait(lock);
+        else
+            this->wakeup.wait_until(lock, next);
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef HOAX_CANCEL_H
+#define HOAX_CANCEL_H
+
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <map>
+
+namespace hoax {
+
+    /** The monotonic wall clock used for all runtime budgets. */
+    typedef std::chrono::steady_clock budget_clock;
+
+    /** A cooperative cancellation flag for a single parity game.
+
+        Long running loops poll the token through `cancelled()` or `check()`,
+        which cost a single relaxed atomic load. A `hoax::Watchdog` sets the
+        flag once the game's runtime budget is exhausted, so the hot loops
+        never read a clock themselves.
+    */
+    class CancelToken {
+    public:
+        /** Why a token was cancelled. */
+        enum Reason : int { NONE = 0, GAME_BUDGET = 1, BATCH_BUDGET = 2, MANUAL = 3 };
+
+        /** @param[in] budget The runtime budget of the game, for diagnostics.
+            @param[in] start The moment the budget started
+        */
+        explicit CancelToken(const budget_clock::duration budget = budget_clock::duration::max(),
+                             const budget_clock::time_point start = budget_clock::now());
+
+        /** True iff. the token was cancelled. */
+        bool cancelled() const { return this->reason.load(std::memory_order_relaxed) != NONE; }
+
+        /** Throw a `std::runtime_error` iff. the token was cancelled. */
+        void check() const {
+            if (this->cancelled())
+                this->raise();
+        }
+
+        /** Cancel the token; the first reason given sticks. */
+        void cancel(const Reason why = MANUAL);
+
+        /** The wall clock seconds since the token was created. */
+        double elapsed() const;
+
+        /** The moment the token was created. */
+        const budget_clock::time_point start;
+        /** The runtime budget the token was created with. */
+        const budget_clock::duration budget;
+
+    private:
+        std::atomic<int> reason;
+
+        /* Build and throw the cancellation error; kept out of line so the
+           inlined `check()` stays small. */
+        [[noreturn]] void raise() const;
+    };
+
+    /** A background timer thread that cancels tokens when their budget runs out.
+
+        Besides a per game budget, the watchdog supports a single batch
+        budget: once the batch deadline passes, every armed token is cancelled
+        and every token armed afterwards starts out cancelled.
+
+        Do not create a watchdog before calling `fork()`, since the child
+        process does not inherit the timer thread.
+    */
+    class Watchdog {
+    public:
+        Watchdog();
+        ~Watchdog();
+        Watchdog(const Watchdog&) = delete;
+        Watchdog &operator=(const Watchdog&) = delete;
+
+        /** Create a token that is cancelled once the given budget runs out.
+
+            A budget can be resumed: if part of it was spent before, e.g.
+            before the game waited in a queue, then the token starts that
+            long ago, so only the remaining budget is left.
+
+            @param[in] budget The runtime budget, starting now
+            @param[in] spent The part of the budget that was already spent
+            @return The armed token
+        */
+        std::shared_ptr<CancelToken> arm(const budget_clock::duration budget,
+                                         const budget_clock::duration spent = budget_clock::duration::zero());
+
+        /** Set the absolute deadline of the entire batch of games. */
+        void set_batch_deadline(const budget_clock::time_point deadline);
+
+    private:
+        /* The timer loop run by the watchdog thread. */
+        void run();
+
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        bool stopping = false;
+        budget_clock::time_point batch_deadline = budget_clock::time_point::max();
+        bool batch_expired = false;
+        std::multimap<budget_clock::time_point, std::weak_ptr<CancelToken>> deadlines;
+        std::thread thread;
+    };
+}
+
+#endif
@@ -0,0 +1,176 @@
+#include "certificate.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+
+/** The index of a vertex that was not visited by Tarjan's algorithm yet. */
+const uint32_t TARJAN_UNVISITED = UINT32_MAX;
+
+/** The label of a vertex that is not part of any sub-graph (anymore). */
+const uint32_t LABEL_NONE = UINT32_MAX;
+
+/** Find a cycle in the strategy restricted winning region of a player, on
+    which the most significant priority is bad for that player.
+
+    @param[in] arena The parity arena
+    @param[in] winners The winner of every vertex, true iff. the "odd player"
+    @param[in] strategy The successor chosen by the owner of every vertex
+    @param[in] player The player whose winning region to check, true iff. "odd"
+    @return A description of a bad cycle, or the empty string iff. there is none
+*/
+static std::string check_cycles(const hoax::Arena &arena, const std::vector<bool> &winners,
+                                const std::vector<int> &strategy, const bool player) {
+    const unsigned int n = arena.num_states;
+
+    /* The player only keeps its strategy edge, the opponent keeps all edges. */
+    auto degree = [&](const uint32_t v) -> uint32_t {
+        return arena.owner(v) == player ? 1 : arena.offsets[v + 1] - arena.offsets[v];
+    };
+    auto successor = [&](const uint32_t v, const uint32_t pos) -> uint32_t {
+        return arena.owner(v) == player ? strategy[v] : arena.targets[arena.offsets[v] + pos];
+    };
+    /* True iff. priority p is more significant than priority q. */
+    auto dominates = [&](const int p, const int q) {
+        return arena.parity_max ? p > q : p < q;
+    };
+
+    /* Every sub-graph still to decompose has a unique label, and an edge
+        only counts if both of its ends have the same label. */
+    std::vector<uint32_t> label(n, LABEL_NONE);
+    std::vector<std::vector<uint32_t>> work(1);
+    for (uint32_t v = 0; v < n; v++)
+        if (winners[v] == player) {
+            label[v] = 0;
+            work[0].push_back(v);
+        }
+    uint32_t next_label = 1;
+
+    std::vector<uint32_t> index(n, TARJAN_UNVISITED);
+    std::vector<uint32_t> lowlink(n, 0);
+    std::vector<bool> on_stack(n, false);
+    std::vector<uint32_t> stack;
+    struct Frame { uint32_t vertex; uint32_t pos; };
+    std::vector<Frame> calls;
+
+    while (!work.empty()) {
+        const std::vector<uint32_t> sub = std::move(work.back());
+        work.pop_back();
+        if (sub.empty())
+            continue;
+        const uint32_t current = label[sub.front()];
+
+        /* An iterative Tarjan, since the recursion could be as deep as the arena. */
+        std::vector<std::vector<uint32_t>> sccs;
+        uint32_t counter = 0;
+        for (const uint32_t root : sub) {
+            if (index[root] != TARJAN_UNVISITED)
+                continue;
+            index[root] = lowlink[root] = counter++;
+            stack.push_back(root);
+            on_stack[root] = true;
+            calls.push_back({root, 0});
+
+            while (!calls.empty()) {
+                const uint32_t v = calls.back().vertex;
+                if (calls.back().pos < degree(v)) {
+                    const uint32_t w = successor(v, calls.back().pos++);
+                    if (label[w] != current)
+                        continue;
+                    if (index[w] == TARJAN_UNVISITED) {
+                        index[w] = lowlink[w] = counter++;
+                        stack.push_back(w);
+                        on_stack[w] = true;
+                        calls.push_back({w, 0});
+                    } else if (on_stack[w]) {
+                        lowlink[v] = std::min(lowlink[v], index[w]);
+                    }
+                    continue;
+                }
+
+                calls.pop_back();
+                if (!calls.empty())
+                    lowlink[calls.back().vertex] = std::min(lowlink[calls.back().vertex], lowlink[v]);
+                if (lowlink[v] == index[v]) {
+                    std::vector<uint32_t> scc;
+                    uint32_t w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = false;
+                        scc.push_back(w);
+                    } while (w != v);
+                    sccs.push_back(std::move(scc));
+                }
+            }
+        }
+        for (const uint32_t v : sub)
+            index[v] = TARJAN_UNVISITED;
+
+        for (std::vector<uint32_t> &scc : sccs) {
+            /* A single vertex is only a cycle if it has a self loop. */
+            bool cyclic = scc.size() > 1;
+            for (uint32_t pos = 0; !cyclic && pos < degree(scc[0]); pos++)
+                cyclic = successor(scc[0], pos) == scc[0];
+            if (!cyclic) {
+                label[scc[0]] = LABEL_NONE;
+                continue;
+            }
+
+            uint32_t top = scc[0];
+            for (const uint32_t v : scc)
+                if (dominates(arena.priority(v), arena.priority(top)))
+                    top = v;
+            const int q = arena.priority(top);
+            if ((std::abs(q) % 2 == 1) != player)
+                return std::string("A cycle through vertex ") + std::to_string(top) +
+                    " has the most significant priority " + std::to_string(q) +
+                    ", which is bad for the " + (player ? "odd" : "even") + " player";
+
+            /* Every cycle through a vertex of priority q is won, so only the
+                cycles that avoid those vertices remain to be checked. */
+            const uint32_t rest_label = next_label++;
+            std::vector<uint32_t> rest;
+            for (const uint32_t v : scc) {
+                if (arena.priority(v) == q) {
+                    label[v] = LABEL_NONE;
+                } else {
+                    label[v] = rest_label;
+                    rest.push_back(v);
+                }
+            }
+            work.push_back(std::move(rest));
+        }
+    }
+    return "";
+}
+
+std::string hoax::check_solution(const hoax::Arena &arena, const std::vector<bool> &winners,
+                                 const std::vector<int> &strategy) {
+    const unsigned int n = arena.num_states;
+    if (winners.size() != n || strategy.size() != n)
+        return "The solution does not cover every vertex of the arena";
+
+    for (uint32_t v = 0; v < n; v++) {
+        const bool player = winners[v];
+        if (arena.owner(v) == player) {
+            const int s = strategy[v];
+            bool valid = false;
+            for (const uint32_t dst : arena.successors(v))
+                valid |= (int) dst == s;
+            if (!valid || winners[s] != player)
+                return "Vertex " + std::to_string(v) + " has no strategy successor in its winning region";
+        } else {
+            for (const uint32_t dst : arena.successors(v))
+                if (winners[dst] != player)
+                    return "The opponent escapes from vertex " + std::to_string(v) +
+                        " to vertex " + std::to_string(dst);
+        }
+    }
+
+    for (const bool player : {false, true}) {
+        std::string reason = check_cycles(arena, winners, strategy, player);
+        if (!reason.empty())
+            return reason;
+    }
+    return "";
+}
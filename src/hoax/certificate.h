@@ -0,0 +1,41 @@
+#ifndef HOAX_CERTIFICATE_H
+#define HOAX_CERTIFICATE_H
+
+#include "arena.h"
+#include <string>
+#include <vector>
+
+namespace hoax {
+
+    /** Check that winning regions and positional strategies solve an arena.
+
+        The winning regions plus strategies form a certificate that can be
+        checked independently of the solver that produced it. For both
+        players `i`, with winning region `W_i`:
+
+        1) `W_i` is a trap for the opponent: every successor of an opponent
+           vertex in `W_i` is in `W_i`.
+        2) `W_i` is closed under the strategy: every vertex of player `i` in
+           `W_i` has a strategy successor in `W_i`.
+        3) Every cycle of the strategy restricted sub-graph on `W_i` has a
+           most significant priority that is good for player `i`.
+
+        The priorities must be normalized, see `hoax::priority`, so an even
+        priority is good for the "even player". The cycles are checked by
+        repeatedly decomposing into SCCs, and removing the most significant
+        priority of every SCC that is good for player `i`. So the check takes
+        `O(d * (n + m))` time for `d` priorities, but it is close to linear
+        time on most arenas.
+
+        @param[in] arena The parity arena
+        @param[in] winners The winner of every vertex, true iff. the "odd player"
+        @param[in] strategy The successor chosen by the owner of every vertex,
+                            or -1 where the owner does not win the vertex
+        @return The first violation found, or the empty string iff. the
+                certificate is valid
+    */
+    std::string check_solution(const hoax::Arena &arena, const std::vector<bool> &winners,
+                               const std::vector<int> &strategy);
+}
+
+#endif
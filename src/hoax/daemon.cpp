@@ -0,0 +1,51 @@
+#include "daemon.h"
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+int hoax::listen_unix(const std::filesystem::path &path) {
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.string().size() >= sizeof(addr.sun_path))
+        throw std::runtime_error("The socket path is too long: " + path.string());
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        throw std::runtime_error(std::string("Could not create socket: ") + strerror(errno));
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        const std::string reason = strerror(errno);
+        close(fd);
+        throw std::runtime_error("Could not listen on " + path.string() + ": " + reason);
+    }
+    return fd;
+}
+
+int hoax::accept_unix(const int fd) {
+    while (true) {
+        const int client = accept(fd, nullptr, nullptr);
+        if (client >= 0)
+            return client;
+        if (errno != EINTR)
+            throw std::runtime_error(std::string("Could not accept a connection: ") + strerror(errno));
+    }
+}
+
+bool hoax::write_all(const int fd, const std::string &data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        written += n;
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef HOAX_DAEMON_H
+#define HOAX_DAEMON_H
+
+#include <filesystem>
+#include <string>
+
+namespace hoax {
+
+    /** Listen for connections on a Unix domain socket.
+
+        A stale socket file at the path, e.g. of a daemon that was killed, is
+        removed first.
+
+        @param[in] path The path of the socket file
+        @return The listening socket
+        @throw std::runtime_error If the socket cannot be created or bound
+    */
+    int listen_unix(const std::filesystem::path &path);
+
+    /** Accept the next connection on a listening socket, retrying on signals.
+
+        @param[in] fd The listening socket
+        @return The connected socket
+        @throw std::runtime_error If no connection can be accepted
+    */
+    int accept_unix(const int fd);
+
+    /** Write all of the data to a file descriptor, retrying short writes.
+
+        @param[in] fd The file descriptor to write to
+        @param[in] data The data to write
+        @return false iff. the other end was closed, or another write error occurred
+    */
+    bool write_all(const int fd, const std::string &data);
+}
+
+#endif
@@ -0,0 +1,12 @@
+#include "dense.h"
+#include <cassert>
+
+hoax::DenseArena::DenseArena(const hoax::Arena &arena)
+    : num_words((arena.num_states + 63) / 64), bits(arena.num_states * this->num_words, 0) {
+    assert(hoax::DenseArena::fits(arena));
+    for (uint32_t v = 0; v < arena.num_states; v++) {
+        uint64_t *row = this->bits.data() + v * this->num_words;
+        for (const uint32_t dst : arena.successors(v))
+            row[dst >> 6] |= uint64_t(1) << (dst & 63);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef HOAX_DENSE_H
+#define HOAX_DENSE_H
+
+#include "arena.h"
+#include <cstdint>
+#include <vector>
+
+namespace hoax {
+
+    /** The maximum number of vertices of an arena to solve with the dense
+        attractor. The adjacency matrix then takes at most 2 MiB. */
+    #define DENSE_MAX_VERTICES 4096
+
+    /** The adjacency matrix of an arena, with one bitset row per vertex.
+
+        Bit `w` of row `v` is set iff. `w` is a successor of `v`. Every row
+        spans `words` 64 bit words, so testing whether some or all successors
+        of a vertex are in a set of vertices is a single pass of word-wise
+        AND/ANDNOT over the row, which the compiler vectorizes, instead of a
+        set lookup per edge.
+    */
+    class DenseArena {
+    public:
+        /** Build the adjacency matrix of an arena.
+
+            @param[in] arena The arena, of at most `DENSE_MAX_VERTICES` vertices
+        */
+        explicit DenseArena(const hoax::Arena &arena);
+
+        /** True iff. the arena is small enough for a dense adjacency matrix. */
+        static bool fits(const hoax::Arena &arena) { return arena.num_states <= DENSE_MAX_VERTICES; }
+
+        /** The number of 64 bit words of every row, and of every vertex bitset. */
+        size_t words() const { return this->num_words; }
+
+        /** Get the successor bitset of the given vertex. */
+        const uint64_t *row(const uint32_t vertex) const { return this->bits.data() + vertex * this->num_words; }
+
+    private:
+        size_t num_words;
+        std::vector<uint64_t> bits;
+    };
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "estimate.h"
+#include "utils.h"
+#include <spot/twaalgos/game.hh>
+#include <stdexcept>
+
+/** Add two counts, saturating at UINT64_MAX. */
+static uint64_t add_saturated(const uint64_t a, const uint64_t b) {
+    return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+/** Multiply two counts, saturating at UINT64_MAX. */
+static uint64_t mul_saturated(const uint64_t a, const uint64_t b) {
+    return (b != 0 && a > UINT64_MAX / b) ? UINT64_MAX : a * b;
+}
+
+hoax::Engine hoax::parse_engine(const std::string &name) {
+    if (name == "auto")
+        return hoax::ENGINE_AUTO;
+    if (name == "explicit")
+        return hoax::ENGINE_EXPLICIT;
+    if (name == "spot")
+        return hoax::ENGINE_SPOT;
+    throw std::runtime_error("Unknown engine \"" + name + "\", expected auto, explicit or spot");
+}
+
+const char *hoax::engine_name(const hoax::Engine engine) {
+    switch (engine) {
+        case hoax::ENGINE_EXPLICIT: return "explicit";
+        case hoax::ENGINE_SPOT:     return "spot";
+        default:                    return "auto";
+    }
+}
+
+hoax::ExpansionEstimate hoax::estimate_expansion(const spot::twa_graph_ptr aut) {
+    const bdd controllable = spot::get_synthesis_outputs(aut);
+    hoax::ExpansionEstimate estimate;
+    estimate.states = aut->num_states();
+
+    for (unsigned int state = 0; state < aut->num_states(); state++) {
+        /* The same uncontrollable variables as `HOAxParityTwA::expand`. */
+        bdd outvars = bddtrue;
+        uint64_t degree = 0;
+        for (auto &edge : aut->out(state)) {
+            outvars &= hoax::bdd_variables(edge.cond);
+            degree++;
+        }
+        /* A conjunction of k variables has k nodes. */
+        const bdd unc_uvars = bdd_restrict(outvars, controllable);
+        const unsigned int k = unc_uvars == bddtrue ? 0 : bdd_nodecount(unc_uvars);
+        estimate.max_uncontrollable = std::max(estimate.max_uncontrollable, k);
+
+        const uint64_t evals = k >= 64 ? UINT64_MAX : uint64_t(1) << k;
+        estimate.states = add_saturated(estimate.states, evals);
+        estimate.edges = add_saturated(estimate.edges, mul_saturated(evals, degree + 1));
+    }
+
+    estimate.bytes = add_saturated(mul_saturated(estimate.states, ESTIMATE_STATE_BYTES),
+                                   mul_saturated(estimate.edges, ESTIMATE_EDGE_BYTES));
+    return estimate;
+}
+
+hoax::Engine hoax::choose_engine(const hoax::ExpansionEstimate &estimate, const uint64_t budget_bytes) {
+    if (budget_bytes == 0 || estimate.bytes <= budget_bytes)
+        return hoax::ENGINE_EXPLICIT;
+    return hoax::ENGINE_SPOT;
+}
@@ -0,0 +1,80 @@
+#ifndef HOAX_ESTIMATE_H
+#define HOAX_ESTIMATE_H
+
+#include <spot/twa/twagraph.hh>
+#include <cstdint>
+#include <string>
+
+namespace hoax {
+
+    /** The estimated memory of a single expanded state, in bytes: the spot
+        state, its arena vertex, and its nodes in the solver's vertex sets. */
+    #define ESTIMATE_STATE_BYTES 256
+
+    /** The estimated memory of a single expanded edge, in bytes: the spot
+        edge storage, its origin, and its arena successor entry. */
+    #define ESTIMATE_EDGE_BYTES 64
+
+    /** The engines to solve a parity game with. */
+    enum Engine : int {
+        /** Choose the engine from the estimated expansion size, see `hoax::choose_engine`. */
+        ENGINE_AUTO = 0,
+        /** Expand the game explicitly, and solve the arena with zielonka. */
+        ENGINE_EXPLICIT = 1,
+        /** Solve the game symbolically split by spot's `split_2step`, with spot's solver, see `hoax::solve_spot`. */
+        ENGINE_SPOT = 2,
+    };
+
+    /** Parse the name of an engine, i.e. "auto", "explicit" or "spot".
+
+        @param[in] name The name of the engine
+        @return The engine
+        @throw std::runtime_error If the name is unknown
+    */
+    Engine parse_engine(const std::string &name);
+
+    /** Get the name of an engine, the inverse of `hoax::parse_engine`. */
+    const char *engine_name(const Engine engine);
+
+    /** An upper bound of the size of the explicit expansion of a game. */
+    struct ExpansionEstimate {
+        /** The number of states, i.e. source states and "even player" states. */
+        uint64_t states = 0;
+        /** The number of edges into and out of the "even player" states. */
+        uint64_t edges = 0;
+        /** The estimated memory of the expansion and its solver, in bytes. */
+        uint64_t bytes = 0;
+        /** The largest number of uncontrollable APs of a single source state. */
+        unsigned int max_uncontrollable = 0;
+    };
+
+    /** Estimate the size of the explicit expansion of a game, without expanding it.
+
+        The expansion creates an "even player" state for every evaluation of
+        the k uncontrollable APs that the out edges of a source state depend
+        on, with an edge into it and an edge out of it per out edge of the
+        source state. Evaluations that leave no out edge satisfiable are
+        skipped, so 2^k such states is an upper bound. Only the supports of
+        the out edge conditions are computed, which is linear in the size of
+        the automaton.
+
+        @param[in] aut The parity game to estimate the expansion of
+        @return The upper bound of the expansion size, saturated at UINT64_MAX
+    */
+    ExpansionEstimate estimate_expansion(const spot::twa_graph_ptr aut);
+
+    /** Choose the engine to solve a game with.
+
+        The explicit expansion is the fastest engine as long as it fits the
+        memory budget. Beyond that, spot's solver splits every source state by
+        the classes of uncontrollable evaluations with the same satisfiable
+        out edges instead, which is often exponentially smaller.
+
+        @param[in] estimate The estimated expansion size
+        @param[in] budget_bytes The memory budget of a single game, 0 for unlimited
+        @return Either `ENGINE_EXPLICIT` or `ENGINE_SPOT`
+    */
+    Engine choose_engine(const ExpansionEstimate &estimate, const uint64_t budget_bytes);
+}
+
+#endif
@@ -0,0 +1,374 @@
+#include "export.h"
+#include <unordered_map>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
+#include <charconv>
+#include <climits>
+#include <cstring>
+#include <fstream>
+
+/** A vertex that was not visited yet. */
+const uint32_t VERTEX_UNVISITED = UINT32_MAX;
+
+namespace {
+    /** Buffers the output of an exporter, and writes it to the stream in
+        blocks of `EXPORT_BUFFER_SIZE` bytes. Integers are formatted with
+        `std::to_chars`, which skips the locale and sentry of the stream
+        operators for every field. */
+    class BufferedWriter {
+    public:
+        explicit BufferedWriter(std::ostream &out) : out(out), buffer(EXPORT_BUFFER_SIZE) {}
+        ~BufferedWriter() { this->flush(); }
+        BufferedWriter(const BufferedWriter&) = delete;
+        BufferedWriter &operator=(const BufferedWriter&) = delete;
+
+        /** Append raw bytes. */
+        BufferedWriter &write(const void *data, const size_t size) {
+            if (this->used + size > this->buffer.size()) {
+                this->flush();
+                /* Too large to buffer, so write it through. */
+                if (size > this->buffer.size()) {
+                    this->out.write(static_cast<const char*>(data), size);
+                    return *this;
+                }
+            }
+            std::memcpy(this->buffer.data() + this->used, data, size);
+            this->used += size;
+            return *this;
+        }
+
+        BufferedWriter &operator<<(const char *s) { return this->write(s, std::strlen(s)); }
+        BufferedWriter &operator<<(const std::string &s) { return this->write(s.data(), s.size()); }
+        BufferedWriter &operator<<(const char c) { return this->write(&c, 1); }
+
+        /** Append an integer in decimal. */
+        template <typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+        BufferedWriter &operator<<(const T value) {
+            char digits[24];
+            const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+            return this->write(digits, result.ptr - digits);
+        }
+
+        /** Append the bytes of a trivially copyable value. */
+        template <typename T>
+        BufferedWriter &raw(const T &value) { return this->write(&value, sizeof(T)); }
+
+        /** Write the buffered bytes to the stream. */
+        void flush() {
+            this->out.write(this->buffer.data(), this->used);
+            this->used = 0;
+        }
+
+    private:
+        std::ostream &out;
+        std::vector<char> buffer;
+        size_t used = 0;
+    };
+
+    /** The fill color of a vertex or component won by either player. */
+    const char *COLOR_WIN_EVEN = "#c6efce";
+    const char *COLOR_WIN_ODD = "#ffc7ce";
+
+    /** True iff. the priority is not the default least significant priority
+        of the expansion, see `hoax::HOAxParityTwA::build_arena`. */
+    bool has_priority(const int p) { return p != INT_MIN + 1 && p != INT_MAX; }
+
+    /** Write the header of a dot graph, with an arrow to the initial node. */
+    void dot_begin(BufferedWriter &out, const uint64_t init) {
+        out << "digraph \"arena\" {\n"
+            << "  rankdir=LR;\n"
+            << "  node [style=filled, fillcolor=white];\n"
+            << "  I [label=\"\", style=invis, width=0];\n"
+            << "  I -> " << init << ";\n";
+    }
+}
+
+hoax::ExportOptions hoax::parse_export(const std::string &spec) {
+    hoax::ExportOptions options;
+    const std::string name = spec.substr(0, spec.find(':'));
+    if (name == "csv" && name == spec)
+        options.format = hoax::EXPORT_CSV;
+    else if (name == "binary" && name == spec)
+        options.format = hoax::EXPORT_BINARY;
+    else if (name == "scc" && name == spec)
+        options.format = hoax::EXPORT_SCC;
+    else if (name == "ball")
+        options.format = hoax::EXPORT_BALL;
+    else
+        throw std::runtime_error("Unknown export \"" + spec + "\", expected csv, binary, scc or ball[:RADIUS[@VERTEX]]");
+
+    if (name == spec)
+        return options;
+
+    /* The radius, and optionally the center, of a neighbourhood. */
+    const std::string params = spec.substr(name.size() + 1);
+    const size_t at = params.find('@');
+    const std::string radius = params.substr(0, at);
+    const char *end = radius.data() + radius.size();
+    if (std::from_chars(radius.data(), end, options.radius).ptr != end || radius.empty())
+        throw std::runtime_error("Invalid radius in export \"" + spec + "\"");
+    if (at != std::string::npos) {
+        const std::string center = params.substr(at + 1);
+        end = center.data() + center.size();
+        uint32_t vertex;
+        if (std::from_chars(center.data(), end, vertex).ptr != end || center.empty())
+            throw std::runtime_error("Invalid vertex in export \"" + spec + "\"");
+        options.center = vertex;
+    }
+    return options;
+}
+
+void hoax::export_csv(std::ostream &vertices, std::ostream &edges, const hoax::Arena &arena,
+                      const std::vector<bool> &winners) {
+    {
+        BufferedWriter out(vertices);
+        out << "vertex,owner,priority,winner\n";
+        for (uint32_t v = 0; v < arena.num_states; v++) {
+            out << v << ',' << int(arena.owner(v)) << ',' << arena.priority(v) << ',';
+            if (!winners.empty())
+                out << int(winners[v]);
+            out << '\n';
+        }
+    }
+
+    BufferedWriter out(edges);
+    out << "src,dst\n";
+    for (uint32_t v = 0; v < arena.num_states; v++)
+        for (const uint32_t dst : arena.successors(v))
+            out << v << ',' << dst << '\n';
+}
+
+void hoax::export_binary(std::ostream &os, const hoax::Arena &arena, const std::vector<bool> &winners) {
+    BufferedWriter out(os);
+    out.write(EXPORT_BINARY_MAGIC, 8);
+    const uint32_t header[4] = {
+        EXPORT_BINARY_VERSION,
+        uint32_t(arena.parity_max) | uint32_t(arena.parity_odd) << 1,
+        arena.num_states,
+        arena.init_state,
+    };
+    out.raw(header);
+    out.raw(uint64_t(arena.num_edges));
+
+    for (uint32_t v = 0; v < arena.num_states; v++)
+        out.raw(int32_t(arena.priority(v)));
+    for (uint32_t v = 0; v < arena.num_states; v++) {
+        uint8_t attributes = arena.owner(v);
+        if (!winners.empty())
+            attributes |= 2 | winners[v] << 2;
+        out.raw(attributes);
+    }
+    for (uint32_t v = 0; v < arena.num_states; v++)
+        for (const uint32_t dst : arena.successors(v)) {
+            const uint32_t edge[2] = {v, dst};
+            out.raw(edge);
+        }
+}
+
+void hoax::export_ball(std::ostream &os, const hoax::Arena &arena, const std::vector<bool> &winners,
+                       const unsigned int center, const unsigned int radius) {
+    if (center >= arena.num_states)
+        throw std::runtime_error("The center " + std::to_string(center) + " of the neighbourhood is not a vertex");
+
+    /* Breadth-first up to the radius. The distances are kept in a map,
+        so the cost only depends on the size of the neighbourhood. */
+    std::unordered_map<uint32_t, unsigned int> distance = {{center, 0}};
+    std::vector<uint32_t> ball = {center};
+    for (size_t i = 0; i < ball.size(); i++) {
+        const uint32_t v = ball[i];
+        const unsigned int d = distance[v];
+        if (d == radius)
+            continue;
+        for (const uint32_t dst : arena.successors(v))
+            if (distance.emplace(dst, d + 1).second)
+                ball.push_back(dst);
+    }
+
+    BufferedWriter out(os);
+    dot_begin(out, center);
+    for (const uint32_t v : ball) {
+        bool boundary = false;
+        for (const uint32_t dst : arena.successors(v))
+            boundary |= distance.find(dst) == distance.end();
+
+        /* The "odd player" vertices are boxes, the "even player" ones circles. */
+        const int p = arena.priority(v);
+        out << "  " << v << " [label=\"" << v;
+        if (has_priority(p))
+            out << "\\n" << p;
+        out << "\", shape=" << (arena.owner(v) ? "box" : "circle");
+        if (!winners.empty())
+            out << ", fillcolor=\"" << (winners[v] ? COLOR_WIN_ODD : COLOR_WIN_EVEN) << "\"";
+        if (boundary)
+            out << ", style=\"filled,dashed\"";
+        out << "];\n";
+    }
+    for (const uint32_t v : ball)
+        for (const uint32_t dst : arena.successors(v))
+            if (distance.find(dst) != distance.end())
+                out << "  " << v << " -> " << dst << ";\n";
+    out << "}\n";
+}
+
+unsigned int hoax::export_scc(std::ostream &os, const hoax::Arena &arena, const std::vector<bool> &winners) {
+    const unsigned int n = arena.num_states;
+
+    /* Tarjan's algorithm, with an explicit call stack. A vertex that was
+        visited, but has no component yet, is on the Tarjan stack. */
+    std::vector<uint32_t> index(n, VERTEX_UNVISITED), low(n), component(n, VERTEX_UNVISITED);
+    std::vector<uint32_t> stack;
+    /* The vertex and its next edge, of every frame. */
+    std::vector<std::pair<uint32_t, uint32_t>> calls;
+    uint32_t next_index = 0, num_components = 0;
+    for (uint32_t root = 0; root < n; root++) {
+        if (index[root] != VERTEX_UNVISITED)
+            continue;
+        index[root] = low[root] = next_index++;
+        stack.push_back(root);
+        calls.emplace_back(root, arena.offsets[root]);
+
+        while (!calls.empty()) {
+            const uint32_t v = calls.back().first;
+            const uint32_t e = calls.back().second;
+            if (e < arena.offsets[v + 1]) {
+                calls.back().second++;
+                const uint32_t w = arena.targets[e];
+                if (index[w] == VERTEX_UNVISITED) {
+                    index[w] = low[w] = next_index++;
+                    stack.push_back(w);
+                    calls.emplace_back(w, arena.offsets[w]);
+                } else if (component[w] == VERTEX_UNVISITED) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+                continue;
+            }
+
+            /* All successors are done; v is the root of a component iff. it
+                reaches no vertex below it on the stack. */
+            if (low[v] == index[v]) {
+                uint32_t w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    component[w] = num_components;
+                } while (w != v);
+                num_components++;
+            }
+            calls.pop_back();
+            if (!calls.empty())
+                low[calls.back().first] = std::min(low[calls.back().first], low[v]);
+        }
+    }
+
+    /* Summarize every component. */
+    struct Summary {
+        uint32_t size = 0;
+        int priority_min = INT_MAX;
+        int priority_max = INT_MIN;
+        bool cyclic = false;
+        bool won_even = false;
+        bool won_odd = false;
+    };
+    std::vector<Summary> summaries(num_components);
+    std::vector<uint64_t> edges;
+    for (uint32_t v = 0; v < n; v++) {
+        Summary &summary = summaries[component[v]];
+        summary.size++;
+        const int p = arena.priority(v);
+        if (has_priority(p)) {
+            summary.priority_min = std::min(summary.priority_min, p);
+            summary.priority_max = std::max(summary.priority_max, p);
+        }
+        if (!winners.empty())
+            (winners[v] ? summary.won_odd : summary.won_even) = true;
+        for (const uint32_t dst : arena.successors(v)) {
+            if (component[dst] == component[v])
+                summary.cyclic = true;
+            else
+                edges.push_back(uint64_t(component[v]) << 32 | component[dst]);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    BufferedWriter out(os);
+    dot_begin(out, component[arena.init_state]);
+    for (uint32_t c = 0; c < num_components; c++) {
+        const Summary &summary = summaries[c];
+        out << "  " << c << " [shape=box, label=\"#" << c << "\\n" << summary.size
+            << (summary.size == 1 ? " vertex" : " vertices");
+        if (summary.priority_min <= summary.priority_max) {
+            out << "\\np " << summary.priority_min;
+            if (summary.priority_max != summary.priority_min)
+                out << ".." << summary.priority_max;
+        }
+        out << "\"";
+        /* Plays only stay forever in the components with a cycle. */
+        if (summary.cyclic)
+            out << ", peripheries=2";
+        if (summary.won_even != summary.won_odd)
+            out << ", fillcolor=\"" << (summary.won_odd ? COLOR_WIN_ODD : COLOR_WIN_EVEN) << "\"";
+        out << "];\n";
+    }
+    for (const uint64_t edge : edges)
+        out << "  " << uint32_t(edge >> 32) << " -> " << uint32_t(edge) << ";\n";
+    out << "}\n";
+    return num_components;
+}
+
+std::vector<std::filesystem::path> hoax::export_arena(const std::filesystem::path &path_in,
+                                                      const std::filesystem::path &path_out,
+                                                      const hoax::ExportOptions &options,
+                                                      const hoax::Arena &arena,
+                                                      const std::vector<bool> &winners) {
+    std::filesystem::create_directories(path_out);
+    const std::string path_base = path_out.string() + path_in.filename().string();
+    std::vector<std::filesystem::path> paths;
+    auto open = [&paths](const std::string &path, const bool binary) {
+        paths.push_back(path);
+        std::ofstream file(path, binary ? std::ios::binary | std::ios::trunc : std::ios::trunc);
+        if (!file.is_open())
+            throw std::runtime_error("Could not open ofstream to export to " + path);
+        return file;
+    };
+    auto check = [](const std::ofstream &file, const std::filesystem::path &path) {
+        if (!file)
+            throw std::runtime_error("Could not export to " + path.string());
+    };
+
+    switch (options.format) {
+    case hoax::EXPORT_CSV: {
+        std::ofstream vertices = open(path_base + ".vertices.csv", false);
+        std::ofstream edges = open(path_base + ".edges.csv", false);
+        hoax::export_csv(vertices, edges, arena, winners);
+        vertices.close();
+        edges.close();
+        check(vertices, paths[0]);
+        check(edges, paths[1]);
+        return paths;
+    }
+    case hoax::EXPORT_BINARY: {
+        std::ofstream file = open(path_base + ".edges.bin", true);
+        hoax::export_binary(file, arena, winners);
+        file.close();
+        check(file, paths[0]);
+        return paths;
+    }
+    case hoax::EXPORT_BALL: {
+        const uint64_t center = options.center < 0 ? arena.init_state : options.center;
+        std::ofstream file = open(path_base + ".ball" + std::to_string(center) + ".dot", false);
+        hoax::export_ball(file, arena, winners, center, options.radius);
+        file.close();
+        check(file, paths[0]);
+        return paths;
+    }
+    default: {
+        std::ofstream file = open(path_base + ".scc.dot", false);
+        hoax::export_scc(file, arena, winners);
+        file.close();
+        check(file, paths[0]);
+        return paths;
+    }
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef HOAX_EXPORT_H
+#define HOAX_EXPORT_H
+
+#include "arena.h"
+#include <filesystem>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hoax {
+
+    /** The size in bytes of the output buffer of the exporters. */
+    #define EXPORT_BUFFER_SIZE (1 << 20)
+    /** The magic bytes of a binary edge list. */
+    #define EXPORT_BINARY_MAGIC "HOAXEDGE"
+    /** The version of the binary edge list format. */
+    #define EXPORT_BINARY_VERSION 1
+    /** The default radius of a neighbourhood export. */
+    #define EXPORT_DEFAULT_RADIUS 2
+
+    /** The formats of `hoax::export_arena`. */
+    enum ExportFormat : int {
+        /** A vertex table and an edge list, as CSV; see `hoax::export_csv`. */
+        EXPORT_CSV = 0,
+        /** A compact binary edge list; see `hoax::export_binary`. */
+        EXPORT_BINARY = 1,
+        /** The bounded radius neighbourhood of a vertex, as dot; see `hoax::export_ball`. */
+        EXPORT_BALL = 2,
+        /** The graph of strongly connected components, as dot; see `hoax::export_scc`. */
+        EXPORT_SCC = 3,
+    };
+
+    /** What and how to export an arena. */
+    struct ExportOptions {
+        hoax::ExportFormat format = hoax::EXPORT_CSV;
+        /** The radius of a neighbourhood, in edges. */
+        unsigned int radius = EXPORT_DEFAULT_RADIUS;
+        /** The center of a neighbourhood, or -1 for the initial vertex. */
+        int64_t center = -1;
+    };
+
+    /** Parse an export specification, i.e. "csv", "binary", "scc" or
+        "ball[:RADIUS[@VERTEX]]", e.g. "ball:3@17" for all vertices within 3
+        edges of vertex 17.
+
+        @param[in] spec The export specification
+        @return The export options
+        @throw std::runtime_error If the specification is malformed
+    */
+    ExportOptions parse_export(const std::string &spec);
+
+    /** Write the vertices and the edges of an arena as two CSV tables.
+
+        The vertex table has the columns `vertex,owner,priority,winner`,
+        where the owner and the winner are 0 for the "even player" and 1 for
+        the "odd player", and the winner is empty if it is unknown. The edge
+        table has the columns `src,dst`.
+
+        @param[out] vertices The stream to write the vertex table to
+        @param[out] edges The stream to write the edge table to
+        @param[in] arena The arena to export
+        @param[in] winners The winner of every vertex, or empty if unknown
+    */
+    void export_csv(std::ostream &vertices, std::ostream &edges, const hoax::Arena &arena,
+                    const std::vector<bool> &winners);
+
+    /** Write an arena as a compact binary edge list.
+
+        All integers are in the byte order of the host, as in the arena
+        cache. The file is:
+        - the 8 magic bytes `EXPORT_BINARY_MAGIC`,
+        - the `uint32_t` version, flags (bit 0 "parity max", bit 1 "parity
+          odd"), number of vertices `n`, and initial vertex,
+        - the `uint64_t` number of edges `m`,
+        - `n` times the `int32_t` priority of a vertex,
+        - `n` times the `uint8_t` attributes of a vertex: bit 0 is set iff.
+          the "odd player" owns it, bit 1 iff. its winner is known, and bit 2
+          iff. the "odd player" wins it,
+        - `m` times the `uint32_t` pair (src, dst) of an edge, by source.
+
+        @param[out] out The binary stream to write to
+        @param[in] arena The arena to export
+        @param[in] winners The winner of every vertex, or empty if unknown
+    */
+    void export_binary(std::ostream &out, const hoax::Arena &arena, const std::vector<bool> &winners);
+
+    /** Write the neighbourhood of a vertex as a dot graph.
+
+        The neighbourhood is every vertex that is reachable from the center
+        in at most `radius` edges, and the edges between them. Its size only
+        depends on the radius and the out degrees, not on the arena size, so
+        it stays renderable for any arena. Vertices on the boundary, i.e.
+        with successors outside of the neighbourhood, are dashed.
+
+        @param[out] out The stream to write to
+        @param[in] arena The arena to export
+        @param[in] winners The winner of every vertex, or empty if unknown
+        @param[in] center The center vertex
+        @param[in] radius The maximum distance from the center, in edges
+        @throw std::runtime_error If the center is not a vertex of the arena
+    */
+    void export_ball(std::ostream &out, const hoax::Arena &arena, const std::vector<bool> &winners,
+                     const unsigned int center, const unsigned int radius);
+
+    /** Write the condensation of an arena, i.e. its graph of strongly
+        connected components, as a dot graph.
+
+        Every component is a single node, labeled with its number of
+        vertices and its range of priorities, and colored by its winner iff.
+        all of its vertices have the same winner. Every edge between two
+        components is drawn once.
+
+        @param[out] out The stream to write to
+        @param[in] arena The arena to export
+        @param[in] winners The winner of every vertex, or empty if unknown
+        @return The number of components
+    */
+    unsigned int export_scc(std::ostream &out, const hoax::Arena &arena, const std::vector<bool> &winners);
+
+    /** Export an arena to files, in the given format.
+
+        The files are named after the input file, with an extension per
+        format, e.g. "game.ehoa.edges.csv" and "game.ehoa.vertices.csv".
+
+        @param[in] path_in The path to the input file of the parity game
+        @param[in] path_out The path to the output directory, which is
+                            created if it does not exist
+        @param[in] options What and how to export
+        @param[in] arena The arena to export
+        @param[in] winners The winner of every vertex, or empty if unknown
+        @return The paths of the written files
+        @throw std::runtime_error If a file could not be written
+    */
+    std::vector<std::filesystem::path> export_arena(const std::filesystem::path &path_in,
+                                                    const std::filesystem::path &path_out,
+                                                    const ExportOptions &options,
+                                                    const hoax::Arena &arena,
+                                                    const std::vector<bool> &winners);
+}
+
+#endif
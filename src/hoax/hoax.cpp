@@ -1,12 +1,71 @@
 #include "hoax.h"
-
-hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const clock_t &start_t, const clock_t &deadline_t) : start(start_t), deadline(deadline_t) {
+#include "certificate.h"
+#include "quotient.h"
+#include "priority_index.h"
+#include "kernels.h"
+#include <spot/twaalgos/synthesis.hh>
+#include <algorithm>
+#include <unordered_map>
+
+hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const std::shared_ptr<const hoax::CancelToken> &token) : token(token) {
+    assert(token != nullptr);
     assert(aut != nullptr);
     assert(this->exp == nullptr);
     assert(this->src == nullptr);
 
     this->src = aut;
+    this->properties = hoax::declared_properties(aut);
+    this->stats.properties = this->properties.names();
+    this->expand(nullptr);
+    this->build_arena();
+}
+
+namespace {
+    /** Check whether two expanded TwAs have the same states and edges, with
+        the same numbers, regardless of their conditions and acceptance sets. */
+    bool same_expansion(const spot::twa_graph &exp1, const spot::twa_graph &exp2) {
+        if (exp1.num_states() != exp2.num_states())
+            return false;
+        const auto &edges1 = exp1.edge_vector();
+        const auto &edges2 = exp2.edge_vector();
+        if (edges1.size() != edges2.size())
+            return false;
+        for (size_t edge = 1; edge < edges1.size(); edge++)
+            if (edges1[edge].src != edges2[edge].src || edges1[edge].dst != edges2[edge].dst)
+                return false;
+        return true;
+    }
+}
+
+hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const hoax::HOAxParityTwA &previous,
+                                   const std::shared_ptr<const hoax::CancelToken> &token) : token(token) {
+    assert(token != nullptr);
+    assert(aut != nullptr);
+
+    this->src = aut;
+    this->properties = hoax::declared_properties(aut);
+    this->stats.properties = this->properties.names();
+    /* BDDs can only be compared within the same bdd_dict. */
+    const bool reusable = previous.src != nullptr && previous.exp != nullptr &&
+        previous.src->get_dict() == aut->get_dict() &&
+        spot::get_synthesis_outputs(previous.src) == spot::get_synthesis_outputs(aut);
+    this->expand(reusable ? &previous : nullptr);
+    this->build_arena();
+
+    /* The previous solution is a candidate solution iff. only priorities changed. */
+    if (previous.exp != nullptr && previous.winners.size() == previous.arena.num_states &&
+        previous.src->num_states() == aut->num_states() && same_expansion(*previous.exp, *this->exp))
+        this->seed_from(previous);
+}
+
+void hoax::HOAxParityTwA::expand(const hoax::HOAxParityTwA *previous) {
+    const hoax::budget_clock::time_point expand_start = hoax::budget_clock::now();
+    hoax::PerfScope perf(this->stats.perf_expand);
+    hoax::MemoryScope memory(this->stats.memory_expand);
+    const spot::twa_graph_ptr aut = this->src;
     this->exp = spot::make_twa_graph(aut->get_dict());
+    /* Spot reserves edge number 0, so `origins` is indexed by edge number. */
+    this->origins.assign(1, 0);
 
     /* In a spot/HOA TwA every state corresponds to an integer state "index".
         Preallocate one new state for every existing state. This ensures there is
@@ -21,8 +80,19 @@ hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const clock_t
        `bdd_existcomp()`, ... in the following section of spot's docs:
            https://gitlab.lre.epita.fr/spot/spot/-/blob/next/buddy/src/bddop.c#L2212 */
 
+    /* Translates the edge numbers of the previous source automaton to the
+        edge numbers of the current one, for the state being reused. */
+    std::vector<unsigned int> translate;
+    if (previous != nullptr)
+        translate.resize(previous->src->edge_vector().size(), 0);
+
     /* All of the states in the automaton belong to the odd player. */
     for (unsigned int state = 0; state < aut->num_states(); state++) {
+        if (previous != nullptr && this->reuse_state(*previous, state, translate)) {
+            this->stats.states_reused++;
+            continue;
+        }
+
         /* Collect all distinct variables of the out edges as a conjunction. */
         bdd outvars = bddtrue;
         for (auto &edge : aut->out(state))
@@ -56,24 +126,44 @@ hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const clock_t
                     eval &= var;
             }
 
-            std::vector<spot::twa_graph::edge_storage_t*> destinations;
+            /* The enabled edges, with their conditions under the evaluation. */
+            std::vector<std::pair<spot::twa_graph::edge_storage_t*, bdd>> destinations;
+            bdd covered = bddfalse;
             for (auto &edge : aut->out(state)) {
                 /* If the edge is still satisfiable after the odd player chooses
                     a uncontrollable var evaluation, then it induces a new edge.
                     i.e. the even player can still make a move. */
-                if (bdd_satone(bdd_restrict(edge.cond, eval)) != bddfalse)
-                    destinations.push_back(&edge);
+                bdd cond = bdd_restrict(edge.cond, eval);
+                if (cond == bddfalse)
+                    continue;
+                destinations.emplace_back(&edge, cond);
+
+                /* The guards of a deterministic automaton are disjoint, so once
+                    the enabled edges cover every move of the even player, all
+                    remaining edges are disabled. */
+                if (this->properties.deterministic) {
+                    covered |= cond;
+                    if (covered == bddtrue)
+                        break;
+                }
             }
 
             /* The eval of the uncontrollable variables results in none of the
-                out transitions having a satisfiable condition. */
-            if (destinations.size() == 0)
+                out transitions having a satisfiable condition. This is cheap
+                to test, so a declared `complete` property is not trusted here:
+                an "even player" state without edges would break the arena. */
+            if (destinations.size() == 0) {
+                this->stats.evals_skipped++;
                 continue;
+            }
 
             const unsigned int intermediate = this->exp->new_state();
+            this->stats.eve_states++;
             unsigned int edge_id = this->exp->new_acc_edge(state, intermediate, eval);
             /* The intermediary transition does not belong to any accepting set. */
             assert(this->exp->edge_storage(edge_id).acc.count() == 0);
+            assert(this->origins.size() == edge_id);
+            this->origins.push_back(0);
 
             /* For each out edge of the original state, that is still satisfiable
                 given the eval of the uncontrollable vars, add an out edge to the
@@ -85,10 +175,10 @@ hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const clock_t
                     https://spot.lre.epita.fr/concepts.html#trans-edge
                 So, use `new_edge(...)` instead of `new_transition(...)`?
             */
-            for (auto edge : destinations) {
-                bdd cond = bdd_restrict(edge->cond, eval);
+            for (auto &[edge, cond] : destinations) {
                 edge_id = this->exp->new_acc_edge(intermediate, edge->dst, cond);
                 this->exp->edge_storage(edge_id).acc = edge->acc;
+                this->origins.push_back(aut->edge_number(*edge));
             }
         }
         if (indexes) free(indexes);
@@ -102,9 +192,55 @@ hoax::HOAxParityTwA::HOAxParityTwA(const spot::twa_graph_ptr aut, const clock_t
     state_player->resize(this->exp->num_states());
     std::fill_n(state_player->begin(), this->src->num_states(), true);
     std::fill(state_player->begin() + this->src->num_states(), state_player->end(), false);
+    this->stats.time_expand += hoax::seconds_since(expand_start);
 }
 
-bool hoax::HOAxParityTwA::solve_parity_game() const {
+bool hoax::HOAxParityTwA::reuse_state(const hoax::HOAxParityTwA &previous, const unsigned int state,
+                                      std::vector<unsigned int> &translate) {
+    if (state >= previous.src->num_states())
+        return false;
+
+    /* The out edges must match one to one, in order. */
+    auto edges_prev = previous.src->out(state);
+    auto it_prev = edges_prev.begin();
+    for (auto &edge : this->src->out(state)) {
+        if (it_prev == edges_prev.end() || it_prev->dst != edge.dst || it_prev->cond != edge.cond)
+            return false;
+        translate[previous.src->edge_number(*it_prev)] = this->src->edge_number(edge);
+        ++it_prev;
+    }
+    if (it_prev != edges_prev.end())
+        return false;
+
+    /* Copy the "even player" states of the state, in order, and take the
+        acceptance sets from the current source edges. */
+    for (auto &edge_eval : previous.exp->out(state)) {
+        this->assert_deadline();
+        const unsigned int intermediate = this->exp->new_state();
+        this->stats.eve_states++;
+        this->exp->new_acc_edge(state, intermediate, edge_eval.cond);
+        this->origins.push_back(0);
+
+        for (auto &edge_move : previous.exp->out(edge_eval.dst)) {
+            const unsigned int origin = translate[previous.origins[previous.exp->edge_number(edge_move)]];
+            const unsigned int edge_id = this->exp->new_acc_edge(intermediate, edge_move.dst, edge_move.cond);
+            this->exp->edge_storage(edge_id).acc = this->src->edge_storage(origin).acc;
+            this->origins.push_back(origin);
+        }
+    }
+    return true;
+}
+
+hoax::HOAxParityTwA::HOAxParityTwA(const hoax::Arena &arena, const std::shared_ptr<const hoax::CancelToken> &token) : arena(arena), token(token) {
+    assert(token != nullptr);
+    assert(this->src == nullptr);
+    assert(this->exp == nullptr);
+}
+
+void hoax::HOAxParityTwA::build_arena() {
+    hoax::PhaseTimer timer(this->stats.time_priority);
+    hoax::PerfScope perf(this->stats.perf_priority);
+    hoax::MemoryScope memory(this->stats.memory_priority);
     bool parity_max, podd;
     this->src->acc().is_parity(parity_max, podd);
 
@@ -119,40 +255,322 @@ bool hoax::HOAxParityTwA::solve_parity_game() const {
     priorities->resize(this->exp->num_states(), parity_max ? priority_min : priority_max);
     /* Only the "even player" states have actual priorities, by construction
       of the expanded automaton. */
-    for (unsigned int state = 0; state < this->exp->num_states(); state++)
-        if (state_player->at(state) == PEVEN)
-            priorities->at(state) = priority(this->exp, state, parity_max);
-
-    std::set<int> vertices = this->get_all_states();
-    std::set<int> vertices_even = this->get_even_states();
-    auto[W0, W1, _] = hoax::zielonka(vertices, vertices_even, *this, parity_max);
-
-    /* FIXME: Dirty hack; The solver has problems with the number of accepting
-        sets being even VS odd. The proper way to solve this is likely by
-        transforming the edge acceptance sets, like spot does here:
-            https://gitlab.lre.epita.fr/spot/spot/-/blob/next/spot/twaalgos/game.cc#L348
-
-        But this would take brain power and time, so a hack it is:
-                   | parity max   parity min
-        -------------------------------------
-        #Accs EVEN |    swap         swap
-        #Accs ODD  |  dont swap    dont swap
-     */
-    bool num_accs_even = (this->src->acc().num_sets() % 2) == 0;
-    if (num_accs_even) std::swap(W0, W1);
-
-    /* Setup the hoax counterpart to spot's "state-winner" named prop. */
-    auto state_winners_hoax = this->exp->get_or_set_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER);
-    /* Initialize the hoax state winners to the "even player" winning by default. */
-    state_winners_hoax->resize(this->exp->num_states(), PEVEN);
-    /* Overwrite the "odd player" winning states. */
+    if (this->properties.state_acc) {
+        /* Every out edge of a source state carries the colour of the state,
+            and so does every out edge of its "even player" states. So read
+            the colour once per source state, instead of scanning the out
+            edges of every "even player" state. */
+        for (unsigned int state = 0; state < this->src->num_states(); state++) {
+            auto edges = this->src->out(state);
+            if (edges.begin() == edges.end())
+                continue;
+            const int p = priority(edges.begin()->acc, parity_max, podd, this->src->acc().num_sets());
+            for (auto &edge : this->exp->out(state))
+                priorities->at(edge.dst) = p;
+        }
+    }
+
+    /* An "even player" state whose out edges have different priorities
+        cannot carry a single priority, since Eve picks which one the play
+        sees. Such a "mixed" state takes the least significant priority, and
+        each of its edges leads through an edge vertex of its own priority
+        instead. Declared state based acceptance never mixes priorities. */
+    const unsigned int num_states = this->exp->num_states();
+    const unsigned int num_src = this->src->num_states();
+    const int priority_least = parity_max ? priority_min : priority_max;
+    std::vector<bool> mixed(num_states, false);
+    if (!this->properties.state_acc) {
+        for (unsigned int state = 0; state < num_states; state++) {
+            if (state_player->at(state) != PEVEN)
+                continue;
+            auto edges = this->exp->out(state);
+            assert(edges.begin() != edges.end());
+            const int first = priority(edges.begin()->acc, parity_max, podd, this->src->acc().num_sets());
+            for (auto &edge : edges)
+                if (priority(edge.acc, parity_max, podd, this->src->acc().num_sets()) != first) {
+                    mixed[state] = true;
+                    break;
+                }
+            priorities->at(state) = mixed[state] ? priority_least : first;
+        }
+    }
+
+    /* Contract the forced "even player" states, i.e. those whose out edges
+        all lead to the same state, by redirecting their "odd player" edge
+        straight to that state. A forced state's priority must survive, so
+        it moves onto its "odd player" state: every play through the "odd
+        player" state continues to one of its "even player" states, so it
+        may take the least significant priority among those without changing
+        the most significant priority of any cycle. Only the forced states
+        of exactly that priority are contracted. A mixed state is never
+        forced, since its edges to the same state still differ. */
+    std::vector<int> forced(num_states, -1);
+    for (unsigned int state = num_src; state < num_states; state++) {
+        if (mixed[state])
+            continue;
+        int dst = -1;
+        for (auto &edge : this->exp->out(state)) {
+            if (dst >= 0 && (int) edge.dst != dst) {
+                dst = -1;
+                break;
+            }
+            dst = edge.dst;
+        }
+        forced[state] = dst;
+    }
+
+    std::vector<int> vertex_priorities(num_src, priority_least);
+    std::vector<bool> contracted(num_states, false);
+    for (unsigned int state = 0; state < num_src; state++) {
+        int least = parity_max ? INT_MAX : INT_MIN;
+        bool any_forced = false;
+        for (auto &edge : this->exp->out(state)) {
+            const int p = priorities->at(edge.dst);
+            least = parity_max ? std::min(least, p) : std::max(least, p);
+            any_forced |= forced[edge.dst] >= 0;
+        }
+        if (!any_forced)
+            continue;
+        for (auto &edge : this->exp->out(state))
+            if (forced[edge.dst] >= 0 && priorities->at(edge.dst) == least) {
+                contracted[edge.dst] = true;
+                this->stats.eve_contracted++;
+            }
+        vertex_priorities[state] = least;
+    }
+
+    /* The source states keep their numbers, the remaining "even player"
+        states are numbered after them. */
+    this->arena_state.assign(num_states, -1);
+    std::vector<bool> owners(num_src, true);
+    for (unsigned int state = 0; state < num_states; state++) {
+        if (state < num_src) {
+            this->arena_state[state] = state;
+        } else if (!contracted[state]) {
+            this->arena_state[state] = owners.size();
+            owners.push_back(false);
+            vertex_priorities.push_back(priorities->at(state));
+        }
+    }
+
+    /* Resolve the vertex that every edge of `exp` leads to. The edge
+        vertices come last, one per distinct successor and priority, and are
+        shared by all mixed states. An edge vertex only moves on to its
+        successor, so its owner does not matter. */
+    this->edge_target.assign(this->exp->edge_vector().size(), -1);
+    std::vector<uint32_t> edge_successors;
+    std::unordered_map<uint64_t, uint32_t> edge_vertices;
+    for (unsigned int state = 0; state < num_states; state++) {
+        if (this->arena_state[state] < 0)
+            continue;
+        for (auto &edge : this->exp->out(state)) {
+            int target = contracted[edge.dst] ? forced[edge.dst] : this->arena_state[edge.dst];
+            if (mixed[state]) {
+                const int p = priority(edge.acc, parity_max, podd, this->src->acc().num_sets());
+                const uint64_t key = uint64_t(target) << 32 | uint32_t(p);
+                auto [it, inserted] = edge_vertices.emplace(key, owners.size());
+                if (inserted) {
+                    owners.push_back(true);
+                    vertex_priorities.push_back(p);
+                    edge_successors.push_back(target);
+                }
+                target = it->second;
+            }
+            this->edge_target[this->exp->edge_number(edge)] = target;
+        }
+    }
+    this->stats.edge_vertices = edge_successors.size();
+
+    /* Flatten the out edges of every vertex into CSR form. Spot's edge
+      storage is a linked list per state, so this also improves locality. */
+    std::vector<uint32_t> offsets(owners.size() + 1, 0);
+    std::vector<uint32_t> targets;
+    targets.reserve(this->exp->num_edges() + edge_successors.size());
+    uint32_t vertex = 0;
+    for (unsigned int state = 0; state < num_states; state++) {
+        if (this->arena_state[state] < 0)
+            continue;
+        const size_t first = targets.size();
+        bool redirected = mixed[state];
+        for (auto &edge : this->exp->out(state)) {
+            redirected |= contracted[edge.dst];
+            targets.push_back(this->edge_target[this->exp->edge_number(edge)]);
+        }
+        /* Several contracted states, or several edges of a mixed state,
+            can lead to the same vertex. */
+        if (redirected) {
+            std::sort(targets.begin() + first, targets.end());
+            targets.erase(std::unique(targets.begin() + first, targets.end()), targets.end());
+        }
+        offsets[++vertex] = targets.size();
+    }
+    for (const uint32_t successor : edge_successors) {
+        targets.push_back(successor);
+        offsets[++vertex] = targets.size();
+    }
+
+    this->arena = hoax::make_arena(std::move(offsets), std::move(targets),
+                                   owners, vertex_priorities,
+                                   this->arena_state[this->exp->get_init_state_number()],
+                                   parity_max, podd, this->src->acc().num_sets());
+    this->measure_memory();
+}
+
+void hoax::HOAxParityTwA::seed_from(const hoax::HOAxParityTwA &previous) {
+    const unsigned int n = this->arena.num_states;
+    this->seed_winners.assign(n, PEVEN);
+    this->seed_strategy.assign(n, -1);
+
+    /* A contracted state wins like the state it is forced to move to. */
+    auto previous_winner = [&previous](const unsigned int state) -> bool {
+        const int vertex = previous.arena_state[state];
+        return previous.winners[vertex >= 0 ? vertex : previous.exp->out(state).begin()->dst];
+    };
+
+    /* The strategy of a state moves along the first edge that led to the
+        previous strategy successor. A previously contracted state had a
+        single choice, so it takes its first edge. */
+    for (unsigned int state = 0; state < this->exp->num_states(); state++) {
+        const int vertex = this->arena_state[state];
+        if (vertex < 0)
+            continue;
+        this->seed_winners[vertex] = previous_winner(state);
+        const int previous_vertex = previous.arena_state[state];
+        const int previous_target = previous_vertex >= 0 ? previous.strategy[previous_vertex] : -1;
+        for (auto &edge : this->exp->out(state)) {
+            const unsigned int number = this->exp->edge_number(edge);
+            if (previous_vertex < 0 || previous.edge_target[number] == previous_target) {
+                this->seed_strategy[vertex] = this->edge_target[number];
+                break;
+            }
+        }
+    }
+
+    /* An edge vertex wins like its single successor, a source state. */
+    for (unsigned int vertex = n - this->stats.edge_vertices; vertex < n; vertex++) {
+        const uint32_t successor = *this->arena.successors(vertex).begin();
+        this->seed_winners[vertex] = this->seed_winners[successor];
+        this->seed_strategy[vertex] = successor;
+    }
+}
+
+int hoax::HOAxParityTwA::eve_move(const unsigned int state) const {
+    for (auto &edge : this->exp->out(state))
+        if (this->eve_allows(this->exp->edge_number(edge)))
+            return edge.dst;
+    return -1;
+}
+
+bool hoax::HOAxParityTwA::eve_allows(const unsigned int edge) const {
+    const int vertex = this->arena_state.at(this->exp->edge_storage(edge).src);
+    if (vertex < 0)
+        return true;
+    const int target = this->strategy.at(vertex);
+    return target >= 0 && this->edge_target.at(edge) == target;
+}
+
+namespace {
+    /** Solve the whole arena with a solver kernel.
+
+        @param[in] aut The parity game
+        @param[out] W0 The vertices of the supported player of the top call
+        @param[out] W1 The vertices of the other player
+        @return The supported player of the top zielonka call
+    */
+    template <typename Sets, bool ParityMax>
+    unsigned int solve_kernel(const hoax::HOAxParityTwA &aut, std::set<int> &W0, std::set<int> &W1) {
+        const unsigned int n = aut.arena.num_states;
+        std::vector<int> all(n);
+        for (unsigned int vertex = 0; vertex < n; vertex++)
+            all[vertex] = vertex;
+
+        hoax::PriorityIndex index(aut.arena, all, ParityMax);
+        const hoax::Kernel<Sets, ParityMax> kernel(aut);
+        auto [Wcurr, Wprev, player] = aut.options.algorithm == hoax::ALGORITHM_PARYS ?
+            kernel.parys(Sets::from(all, n), index) : kernel.zielonka(Sets::from(all, n), index);
+        W0.insert(Wcurr.begin(), Wcurr.end());
+        W1.insert(Wprev.begin(), Wprev.end());
+        return player;
+    }
+}
+
+bool hoax::HOAxParityTwA::solve_parity_game() const {
+    hoax::PhaseTimer timer(this->stats.time_solve);
+    hoax::MemoryScope memory(this->stats.memory_solve);
+    hoax::TraceScope trace(this->options.tracer.get(), "solve");
+    trace.arg("states", this->arena.num_states);
+    trace.arg("edges", this->arena.num_edges);
+    const bool parity_max = this->arena.parity_max;
+
+    /* Warm start: a previous solution over the same graph is often still
+        valid when only some priorities changed, and checking it takes close
+        to linear time. */
+    this->stats.warm_start = !this->seed_winners.empty() &&
+        hoax::check_solution(this->arena, this->seed_winners, this->seed_strategy).empty();
+
+    std::set<int> W0, W1;
+    if (this->stats.warm_start) {
+        this->strategy = this->seed_strategy;
+        for (unsigned int state = 0; state < this->arena.num_states; state++)
+            (this->seed_winners[state] ? W1 : W0).insert(state);
+    } else if (this->options.quotient) {
+        this->solve_quotient(W0, W1);
+    } else if (this->options.order != hoax::ORDER_NONE) {
+        this->solve_reordered(W0, W1);
+    } else {
+        this->strategy.assign(this->arena.num_states, -1);
+
+        /* Pick the kernel once; the recursion and the attractors then run
+            without testing the parity condition or the set representation. */
+        hoax::SetPolicy sets = this->options.sets;
+        const bool fits = hoax::DenseArena::fits(this->arena);
+        if (sets == hoax::SETS_AUTO)
+            sets = fits ? hoax::SETS_BITSET : hoax::SETS_TREE;
+        if (sets == hoax::SETS_BITSET && fits)
+            this->dense = std::make_shared<const hoax::DenseArena>(this->arena);
+
+        hoax::PerfScope perf(this->stats.perf_zielonka);
+        unsigned int player;
+        switch (sets) {
+        case hoax::SETS_VECTOR:
+            player = parity_max ? solve_kernel<hoax::VectorSets, true>(*this, W0, W1) :
+                                  solve_kernel<hoax::VectorSets, false>(*this, W0, W1);
+            break;
+        case hoax::SETS_BITSET:
+            player = parity_max ? solve_kernel<hoax::BitSets, true>(*this, W0, W1) :
+                                  solve_kernel<hoax::BitSets, false>(*this, W0, W1);
+            break;
+        default:
+            player = parity_max ? solve_kernel<hoax::TreeSets, true>(*this, W0, W1) :
+                                  solve_kernel<hoax::TreeSets, false>(*this, W0, W1);
+            break;
+        }
+
+        /* Zielonka returns the winning region of its supported player first.
+            The priorities are normalized, see `hoax::priority`, so this is all
+            it takes to handle every min/max even/odd condition. */
+        if (player == PODD) std::swap(W0, W1);
+    }
+
+    this->winners.assign(this->arena.num_states, PEVEN);
     for (const auto winner_odd : W1)
-        (*state_winners_hoax)[winner_odd] = PODD;
-    for (const auto winner_even : W0)
-        (*state_winners_hoax)[winner_even] = PEVEN;
+        this->winners[winner_odd] = PODD;
+
+    /* Setup the hoax counterpart to spot's "state-winner" named prop.
+      A cached arena has no expanded TwA to attach the named prop to. */
+    if (this->exp != nullptr) {
+        auto state_winners_hoax = this->exp->get_or_set_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER);
+        state_winners_hoax->resize(this->exp->num_states(), PEVEN);
+        /* A contracted state wins like the state it is forced to move to. */
+        for (unsigned int state = 0; state < this->exp->num_states(); state++) {
+            const int vertex = this->arena_state[state];
+            (*state_winners_hoax)[state] = this->winners[vertex >= 0 ? vertex : this->exp->out(state).begin()->dst];
+        }
+    }
+    this->measure_memory();
 
     // The initial/start state.
-    const unsigned int init_state = this->exp->get_init_state_number();
+    const unsigned int init_state = this->arena.init_state;
 
     /* Solving for "parity odd" is the complement of solving for "parity even"
         and vice versa; exactly one of the players must win from the initial
@@ -169,6 +587,96 @@ bool hoax::HOAxParityTwA::solve_parity_game() const {
     return odd_wins;
 }
 
+void hoax::HOAxParityTwA::solve_quotient(std::set<int> &W0, std::set<int> &W1) const {
+    hoax::Quotient quotient;
+    {
+        hoax::PhaseTimer timer(this->stats.time_reduce);
+        quotient = hoax::bisimulation_quotient(this->arena, this->token);
+    }
+    this->stats.quotient_states = quotient.arena.num_states;
+
+    hoax::HOAxParityTwA reduced(quotient.arena, this->token);
+    reduced.options = this->options;
+    reduced.options.quotient = false;
+    reduced.solve_parity_game();
+
+    this->add_solver_stats(reduced.stats);
+
+    /* Every vertex wins like its class, and moves to some successor in the
+        class that the strategy of its class moves to. */
+    this->strategy.assign(this->arena.num_states, -1);
+    for (unsigned int state = 0; state < this->arena.num_states; state++) {
+        const uint32_t c = quotient.class_of[state];
+        (reduced.winners[c] ? W1 : W0).insert(state);
+
+        const int dst_class = reduced.strategy[c];
+        if (dst_class < 0)
+            continue;
+        for (const uint32_t dst : this->arena.successors(state))
+            if ((int) quotient.class_of[dst] == dst_class) {
+                this->strategy[state] = dst;
+                break;
+            }
+    }
+}
+
+void hoax::HOAxParityTwA::solve_reordered(std::set<int> &W0, std::set<int> &W1) const {
+    hoax::Reordering reordering;
+    {
+        hoax::PhaseTimer timer(this->stats.time_reduce);
+        reordering = hoax::reorder_arena(this->arena, this->options.order);
+    }
+
+    hoax::HOAxParityTwA reordered(reordering.arena, this->token);
+    reordered.options = this->options;
+    reordered.options.order = hoax::ORDER_NONE;
+    reordered.solve_parity_game();
+    this->add_solver_stats(reordered.stats);
+
+    this->strategy.assign(this->arena.num_states, -1);
+    for (unsigned int state = 0; state < this->arena.num_states; state++) {
+        const uint32_t vertex = reordering.new_of[state];
+        (reordered.winners[vertex] ? W1 : W0).insert(state);
+        if (reordered.strategy[vertex] >= 0)
+            this->strategy[state] = reordering.old_of[reordered.strategy[vertex]];
+    }
+}
+
+void hoax::HOAxParityTwA::add_solver_stats(const hoax::Stats &derived) const {
+    /* The solver counters of a derived game are those of this game. */
+    this->stats.zielonka_calls += derived.zielonka_calls;
+    this->stats.zielonka_depth_max = std::max(this->stats.zielonka_depth_max, derived.zielonka_depth_max);
+    this->stats.attractor_calls += derived.attractor_calls;
+    this->stats.attractor_rounds += derived.attractor_rounds;
+    this->stats.edges_scanned += derived.edges_scanned;
+    this->stats.rows_scanned += derived.rows_scanned;
+    this->stats.perf_zielonka.add(derived.perf_zielonka);
+    this->stats.perf_attractor.add(derived.perf_attractor);
+    this->stats.time_reduce += derived.time_reduce;
+    this->stats.quotient_states = std::max(this->stats.quotient_states, derived.quotient_states);
+}
+
+void hoax::HOAxParityTwA::measure_memory() const {
+    this->stats.bytes_arena = hoax::arena_bytes(this->arena);
+    /* A cached arena has neither TwAs nor BDDs. */
+    if (this->exp == nullptr)
+        return;
+    this->stats.bytes_source = hoax::twa_bytes(this->src);
+    this->stats.bytes_expansion = hoax::twa_bytes(this->exp) +
+        this->origins.capacity() * sizeof(unsigned int) + this->arena_state.capacity() * sizeof(int);
+    this->stats.bytes_bdd = hoax::bdd_bytes();
+
+    /* A `std::vector<bool>` packs 8 states into a byte. */
+    uint64_t bytes = 0;
+    if (auto state_player = this->exp->get_named_prop<std::vector<bool>>(PROP_SPOT_STATE_PLAYER))
+        bytes += state_player->capacity() / 8;
+    if (auto priorities = this->exp->get_named_prop<std::vector<int>>(PROP_HOAX_PRIOR))
+        bytes += priorities->capacity() * sizeof(int);
+    if (auto state_winners = this->exp->get_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER))
+        bytes += state_winners->capacity() / 8;
+    this->stats.bytes_named_props = bytes;
+}
+
 void hoax::HOAxParityTwA::set_state_names() {
     auto names = this->exp->get_or_set_named_prop<std::vector<std::string>>("state-names");
     names->resize(this->exp->num_states());
@@ -181,38 +689,26 @@ void hoax::HOAxParityTwA::set_state_names() {
         (*names)[i] = (state_players[i] ? "A" : "E") + std::to_string(i);
 }
 
-void hoax::HOAxParityTwA::assert_deadline() const {
-  const clock_t now = clock();
-  if (now <= this->deadline)
-    return;
-
-  std::string sruntime = std::to_string((now - this->start) / (float)CLOCKS_PER_SEC);
-  std::string sruntime_max = std::to_string((this->deadline - this->start) / (float)CLOCKS_PER_SEC);
-  throw std::runtime_error("Runtime (" + sruntime + "s) exceeds max runtime (" + sruntime_max + "s).");
-}
-
 std::set<int> hoax::HOAxParityTwA::get_all_states() const {
     std::set<int> states;
-    for (unsigned int i = 0; i < this->exp->num_states(); i++)
-        states.insert(i);
+    for (unsigned int i = 0; i < this->arena.num_states; i++)
+        states.insert(states.end(), i);
     return states;
 }
 
 std::set<int> hoax::HOAxParityTwA::get_even_states() const {
     std::set<int> states;
-    auto state_players = spot::get_state_players(this->exp);
-    for (unsigned int i = 0; i < this->exp->num_states(); i++)
-        if (!state_players[i])
-            states.insert(i);
+    for (unsigned int i = 0; i < this->arena.num_states; i++)
+        if (!this->arena.owner(i))
+            states.insert(states.end(), i);
     return states;
 }
 
 std::set<int> hoax::HOAxParityTwA::get_odd_states() const {
     std::set<int> states;
-    auto state_players = spot::get_state_players(this->exp);
-    for (unsigned int i = 0; i < this->exp->num_states(); i++)
-        if (state_players[i])
-            states.insert(i);
+    for (unsigned int i = 0; i < this->arena.num_states; i++)
+        if (this->arena.owner(i))
+            states.insert(states.end(), i);
     return states;
 }
 
@@ -222,75 +718,21 @@ hoax::zielonka(
     const std::set<int> &vertices_even,
     const HOAxParityTwA &aut,
     const bool parity_max) {
+    hoax::PriorityIndex index(aut.arena, vertices, parity_max);
+    return hoax::zielonka(vertices, vertices_even, aut, parity_max, index);
+}
 
-    aut.assert_deadline();
-
-    /* Base case: no more vertices remain to be checked. */
-    if (vertices_even.empty())
-        return std::make_tuple<std::set<int>, std::set<int>>({}, {}, PINVALID);
-
-
-    /* Support a player based on the extremum priority's parity. */
-    auto priorities = aut.exp->get_or_set_named_prop<std::vector<int>>(PROP_HOAX_PRIOR);
-    // The min/max priority, depending on the parity condition.
-    int m = parity_max ? INT_MIN : INT_MAX;
-    for (int vertex : vertices_even) {
-        m = parity_max ? std::max(m, priorities->at(vertex)) :
-                         std::min(m, priorities->at(vertex));
-    }
-    // The player to support.
-    const unsigned int player = std::abs(m) % 2;
-    const unsigned int player_other = 1 - player;
-    assert((player == PEVEN && player_other == PODD) ||
-           (player == PODD  && player_other == PEVEN));
-
-
-    // The vertices matching the extremum priority.
-    std::set<int> M;
-    for (int vertex : vertices_even)
-        if (priorities->at(vertex) == m)
-            M.insert(vertex);
-
-
-    // All remaining odd/Adam vertices.
-    std::set<int> vertices_odd = vertices - vertices_even;
-    std::set<int> R = hoax::attractor(vertices, vertices_odd, vertices_even, aut, M, player);
-
-    // Recursively solve for (G \ R)
-    auto[Wcurr_p1, Wprev_p1, player_rec_R] = hoax::zielonka(vertices - R, vertices_even - R, aut, parity_max);
-    /* The recursive call could support the opposite player than this call does.
-        If so, swap the returned sets so that they match the current supported player.*/
-    if (player_rec_R != player) std::swap(Wcurr_p1, Wprev_p1);
-
-    // The non-supported player cannot escape the attractor.
-    if (Wprev_p1.empty()) {
-        return std::make_tuple<std::set<int>, std::set<int>>(
-            // W_i = W'_i U R
-            std::move(hoax::merge(Wcurr_p1, R)),
-            // W_(i-1) = emptyset
-            {},
-            // The supported player
-            player
-        );
-    // The non-supported player can escape the attractor.
-    } else {
-        std::set<int> S = hoax::attractor(vertices, vertices_odd, vertices_even, aut, Wprev_p1, player_other);
-
-        // Recursively solve for (G \ S)
-        auto[Wcurr_p2, Wprev_p2, player_rec_S] = hoax::zielonka(vertices - S, vertices_even - S, aut, parity_max);
-        /* The recursive call could support the opposite player than this call does.
-            If so, swap the returned sets so that they match the current supported player.*/
-        if (player_rec_S != player) std::swap(Wcurr_p2, Wprev_p2);
-
-        return std::make_tuple<std::set<int>, std::set<int>>(
-            // W_i = W''_i
-            std::move(Wcurr_p2),
-            // W_(i-1) = W''_(i-1) U S
-            std::move(hoax::merge(Wprev_p2, S)),
-            // The supported player
-            player
-        );
-    }
+std::tuple<std::set<int>, std::set<int>, unsigned int>
+hoax::zielonka(
+    const std::set<int> &vertices,
+    const std::set<int> &,
+    const HOAxParityTwA &aut,
+    const bool parity_max,
+    hoax::PriorityIndex &index) {
+    /* The kernel reads the owner of every vertex from the arena. */
+    if (parity_max)
+        return hoax::Kernel<hoax::TreeSets, true>(aut).zielonka(vertices, index);
+    return hoax::Kernel<hoax::TreeSets, false>(aut).zielonka(vertices, index);
 }
 
 std::set<int>
@@ -303,6 +745,11 @@ hoax::attractor(
     const unsigned int i) {
     assert(i == PEVEN || i == PODD); // Avoid invalid player.
 
+    aut.stats.attractor_calls++;
+
+    /* Every vertex of player i is attracted through a successor that was
+        attracted in an earlier round, so recording that successor as the
+        strategy of player i makes progress towards T. */
     // Attr_i^0(G, T) = T
     std::set<int> attr(T.begin(), T.end());
     unsigned int attr_size = attr.size();
@@ -311,21 +758,25 @@ hoax::attractor(
         std::set<int> attr_rec;
 
         aut.assert_deadline();
+        aut.stats.attractor_rounds++;
+        uint64_t edges_scanned = 0;
 
         /* Add all vertices where the player i can choose to enter the
             attractor set themselves. */
         const std::set<int> &vertices_exist = (i == PEVEN) ? vertices_even : vertices_odd;
         for (const int vertex : vertices_exist) {
-            for (auto edge : aut.exp->out(vertex)) {
+            if (hoax::contains(attr, vertex))
+                continue;
+            for (const uint32_t dst : aut.arena.successors(vertex)) {
                 /* We implicitly remove edges from the arena; exclude edges
                     that are not part of the divide-and-conquer sub-arena. */
-                if (!hoax::contains(vertices_all, edge.dst))
+                if (!hoax::contains(vertices_all, dst))
                     continue;
-                // The edge is an out edge of vertex, so vertex should be the src
-                assert(vertex == edge.src);
+                edges_scanned++;
 
-                if (hoax::contains(attr, edge.dst)) {
+                if (hoax::contains(attr, dst)) {
                     attr_rec.insert(vertex);
+                    aut.strategy[vertex] = dst;
                     break;
                 }
             }
@@ -335,17 +786,17 @@ hoax::attractor(
             enter the attractor set. */
         const std::set<int> &vertices_forall = (i == PEVEN) ? vertices_odd : vertices_even;
         for (const int vertex : vertices_forall) {
+            if (hoax::contains(attr, vertex))
+                continue;
             bool forced_into_attractors = true;
-            for (auto edge : aut.exp->out(vertex)) {
+            for (const uint32_t dst : aut.arena.successors(vertex)) {
                 /* We implicitly remove edges from the arena; exclude edges
                     that are not part of the divide-and-conquer sub-arena. */
-                if (!hoax::contains(vertices_all, edge.dst))
+                if (!hoax::contains(vertices_all, dst))
                     continue;
+                edges_scanned++;
 
-                // The edge is an out edge of vertex, so vertex should be the src
-                assert(vertex == edge.src);
-
-                if (!hoax::contains(attr, edge.dst)) {
+                if (!hoax::contains(attr, dst)) {
                     forced_into_attractors = false;
                     break;
                 }
@@ -355,6 +806,7 @@ hoax::attractor(
         }
 
         attr.insert(attr_rec.begin(), attr_rec.end());
+        aut.stats.edges_scanned += edges_scanned;
 
         /* Fixpoint reached, further iteration is redundant. */
         if (attr.size() == attr_size)
@@ -366,30 +818,66 @@ hoax::attractor(
     return attr;
 }
 
-int hoax::priority(const spot::acc_cond::mark_t &mark, const bool parity_max) {
+std::set<int>
+hoax::attractor_dense(
+    const std::set<int> &vertices_all,
+    const HOAxParityTwA &aut,
+    const std::set<int> &T,
+    const unsigned int i) {
+    assert(aut.dense != nullptr);
+
+    /* The parity condition does not matter to an attractor. */
+    const unsigned int n = aut.arena.num_states;
+    const hoax::BitSet attr = hoax::Kernel<hoax::BitSets, true>(aut).attractor(
+        hoax::BitSets::from(vertices_all, n), hoax::BitSets::from(T, n), i);
+    return std::set<int>(attr.begin(), attr.end());
+}
+
+int hoax::priority(const spot::acc_cond::mark_t &mark, const bool parity_max,
+                   const bool parity_odd, const unsigned int num_sets) {
     int p;
-    if (parity_max)
-        p = mark.max_set();
+    /* Spot's `mark_t.max_set()` and `mark_t.min_set()` return 0 when
+      an edge is not part of any transition set. Such an edge gets
+      the least significant priority instead. */
+    if (!mark)
+        p = parity_max ? -1 : num_sets;
+    else if (parity_max)
+        p = mark.max_set() - 1;
     else
-        p = mark.min_set();
+        p = mark.min_set() - 1;
 
-    /* Spot's `mark_t.max_set()` and `mark_t.min_set()` return 0 when
-      an edge is not part of any transition set.
-      ==> Fallthrough priority is -1. */
-    return p - 1;
+    /* Shifting by one turns an odd condition into an even one. */
+    return parity_odd ? p + 1 : p;
 }
 
-int hoax::priority(const spot::twa_graph_ptr aut, const unsigned int state, const bool parity_max) {
+int hoax::priority(const spot::twa_graph_ptr aut, const unsigned int state, const bool parity_max,
+                   const bool parity_odd, const unsigned int num_sets) {
     int p = parity_max ? INT_MIN : INT_MAX;
     bool edges_empty = true;
     for (auto &edge : aut->out(state)) {
         edges_empty = false;
         if (parity_max)
-            p = std::max(p, hoax::priority(edge.acc, parity_max));
+            p = std::max(p, hoax::priority(edge.acc, parity_max, parity_odd, num_sets));
         else
-            p = std::min(p, hoax::priority(edge.acc, parity_max));
+            p = std::min(p, hoax::priority(edge.acc, parity_max, parity_odd, num_sets));
     }
     /* Sink nodes, vertices with no outgoing edges, are not allowed! */
     assert(!edges_empty);
     return p;
 }
+
+bool hoax::solve_spot(const spot::twa_graph_ptr aut) {
+    /* Without completing the environment, an evaluation that leaves no out
+        edge satisfiable is not a move of the environment, as in the explicit
+        expansion. The controller is player 1 of the split game. */
+    spot::twa_graph_ptr split = spot::split_2step(aut, spot::get_synthesis_outputs(aut), false);
+    return spot::solve_game(split);
+}
+
+hoax::Algorithm hoax::parse_algorithm(const std::string &name) {
+    if (name == "zielonka")
+        return hoax::ALGORITHM_ZIELONKA;
+    if (name == "parys")
+        return hoax::ALGORITHM_PARYS;
+    throw std::runtime_error("Unknown algorithm \"" + name + "\", expected zielonka or parys");
+}
@@ -2,6 +2,15 @@
 #define HOAX_H
 
 #include "utils.h"
+#include "arena.h"
+#include "cancel.h"
+#include "stats.h"
+#include "priority_index.h"
+#include "reorder.h"
+#include "dense.h"
+#include "sets.h"
+#include "trace.h"
+#include "properties.h"
 #include <assert.h>
 #include <utility>
 #include <climits>
@@ -30,6 +39,44 @@ namespace hoax {
     #define PROP_HOAX_STATE_WINNER "state-winner-hoax"
     #define PROP_HOAX_PRIOR "priority-hoax"
 
+    /** The recursive algorithms of the solver kernel, see `hoax::Kernel`. */
+    enum Algorithm : int {
+        /** Zielonka's algorithm; see `hoax::Kernel::zielonka`. */
+        ALGORITHM_ZIELONKA = 0,
+        /** Parys' quasi-polynomial variant of Zielonka's algorithm; see
+            `hoax::Kernel::parys`. */
+        ALGORITHM_PARYS = 1,
+    };
+
+    /** Parse the name of a solver algorithm, i.e. "zielonka" or "parys".
+
+        @param[in] name The name of the algorithm
+        @return The algorithm
+        @throw std::runtime_error If the name is unknown
+    */
+    Algorithm parse_algorithm(const std::string &name);
+
+    /** The options of `HOAxParityTwA::solve_parity_game`. */
+    struct SolverOptions {
+        /** If true, then solve the bisimulation quotient of the arena, and
+            map the solution back, see `hoax::bisimulation_quotient`. */
+        bool quotient = false;
+        /** The vertex order to renumber the arena in before solving, and to
+            map the solution back from, see `hoax::reorder_arena`. */
+        hoax::VertexOrder order = hoax::ORDER_NONE;
+        /** The vertex sets of the solver kernel, see `hoax::Kernel`. By
+            default, arenas that fit a dense adjacency matrix use bitsets and
+            the matrix, see `hoax::DenseArena::fits`, and others use trees. */
+        hoax::SetPolicy sets = hoax::SETS_AUTO;
+        /** The recursive algorithm of the solver kernel. Zielonka's is the
+            fastest on most games; Parys' bounds the worst case, see
+            `hoax::Kernel::parys`. */
+        hoax::Algorithm algorithm = hoax::ALGORITHM_ZIELONKA;
+        /** If set, then record every zielonka frame and attractor call, see
+            `hoax::Tracer`. Derived games, e.g. the quotient, share it. */
+        std::shared_ptr<hoax::Tracer> tracer;
+    };
+
     /** An interface for expanding a parity automaton into a parity arena.
 
         In this context, we use "parity automaton" to mean a spot TwA that only
@@ -51,27 +98,102 @@ namespace hoax {
         spot::twa_graph_ptr src;
         /** The expanded TwA, where the even player states have been made explicit. */
         spot::twa_graph_ptr exp;
+        /** The compact arena of the expanded TwA, which the solver operates on. */
+        hoax::Arena arena;
+        /** The properties that the HOA header of `src` declared, which the
+            expansion and the priorities take shortcuts for. */
+        hoax::GameProperties properties;
+
+        /** The options of the solver. */
+        hoax::SolverOptions options;
+        /** The cancellation token of this parity game's runtime budget. */
+        const std::shared_ptr<const hoax::CancelToken> token;
+        /** The instrumentation of this parity game; updated by the solver too. */
+        mutable hoax::Stats stats;
+        /** The winning strategies recorded by `solve_parity_game`.
+
+            For every vertex from which its owner wins, this is the successor
+            that the owner moves to, or -1 if the owner does not need to
+            choose. So restricted to the "even player" winning region, this
+            is a winning strategy for Eve, and vice versa for Adam.
+        */
+        mutable std::vector<int> strategy;
+        /** The winner of every vertex, recorded by `solve_parity_game`;
+            true iff. the "odd player" wins the vertex. */
+        mutable std::vector<bool> winners;
+        /** For every edge of `exp`, the number of the edge of `src` it was
+            expanded from, or 0 for the edges into the "even player" states. */
+        std::vector<unsigned int> origins;
+        /** For every state of `exp`, its vertex in `arena`, or -1 iff. the
+            state is a forced "even player" state that was contracted.
+
+            The source states keep their numbers in the arena. A contracted
+            state only has out edges to a single source state.
+        */
+        std::vector<int> arena_state;
+        /** For every edge of `exp`, the vertex of `arena` that it leads to,
+            or -1 for the out edges of the contracted states.
 
-        /** The deadline's start horizon for this parity game. */
-        const clock_t start;
-        /** A reference deadline to hint when execution should be quit early. */
-        const clock_t deadline;
+            An edge of an "even player" state with mixed priorities leads to
+            an edge vertex, which carries the priority of the edge and moves
+            on to the destination of the edge.
+        */
+        std::vector<int> edge_target;
+        /** The adjacency matrix of the arena, iff. the solver kernel uses
+            bitsets and the arena fits. Set by `solve_parity_game`. */
+        mutable std::shared_ptr<const hoax::DenseArena> dense;
 
     public:
         /** Expands the given parity automaton.
 
             @param[in] aut The parity game to expand
-            @param[in] start_t The deadline's start horizon for this parity game
-            @param[in] deadline_t If this deadline is exceeded, then quit early
+            @param[in] token If this token is cancelled, then quit early
         */
-        HOAxParityTwA(const spot::twa_graph_ptr aut, const clock_t &start_t, const clock_t &deadline_t);
+        HOAxParityTwA(const spot::twa_graph_ptr aut, const std::shared_ptr<const hoax::CancelToken> &token);
 
-        /** Solve a "parity min/max odd" game.
+        /** Expands the given parity automaton, reusing a related game.
+
+            Games that share most of their structure, e.g. several properties
+            checked on the same model, only differ in some of their states.
+            The expansion of a state only depends on its out edges, so every
+            state whose out edges have the same destinations and conditions
+            as in the previous game reuses the previous expansion, with the
+            acceptance sets of the new edges. This requires both automata to
+            share their `spot::bdd_dict`, else nothing is reused.
+
+            If only the priorities changed, i.e. the expanded TwA has the same
+            states and edges as the previous one, then the previous solution
+            seeds `solve_parity_game`. The arenas may still differ, since the
+            contraction and the edge vertices depend on the priorities, so
+            the solution is mapped through the edges of the expanded TwA.
+
+            @param[in] aut The parity game to expand
+            @param[in] previous A previously expanded (and solved) game
+            @param[in] token If this token is cancelled, then quit early
+        */
+        HOAxParityTwA(const spot::twa_graph_ptr aut, const HOAxParityTwA &previous,
+                      const std::shared_ptr<const hoax::CancelToken> &token);
+
+        /** Wrap an already expanded arena, e.g. one loaded from the arena cache.
+
+            No source or expanded TwA is available in this case, so both
+            `src` and `exp` are left as `nullptr`.
+
+            @param[in] arena The expanded parity arena
+            @param[in] token If this token is cancelled, then quit early
+        */
+        HOAxParityTwA(const hoax::Arena &arena, const std::shared_ptr<const hoax::CancelToken> &token);
 
-            i.e. the actual arena may have any acceptance condition,
-            but the algorithm checks if the odd player can win the
-            game from the initial state, given the min/max parity
-            parameter derived from the acceptance condition.
+        /** Solve the parity game, and record the winning strategies.
+
+            A seeded solution is checked with `hoax::check_solution` first,
+            and only if it is not valid for the current priorities, then the
+            game is solved from scratch.
+
+            The priorities of the arena are normalized for the acceptance
+            condition of the game, see `hoax::priority`. So Eve, who picks the
+            controllable APs, wins a play iff. the play is accepting, and the
+            game is realizable iff. Eve wins from the initial state.
 
             @return true iff. the "odd" player wins from the initial state.
                     false else, i.e. the "even" player wins from the initial state.
@@ -81,13 +203,70 @@ namespace hoax {
          */
         bool solve_parity_game() const;
 
+        /** Get the source state that Eve moves to from an "even player"
+            state of `exp`, under the strategy recorded by `solve_parity_game`.
+
+            @param[in] state An "even player" state of `exp`
+            @return The source state, or -1 iff. Eve does not win the state
+        */
+        int eve_move(const unsigned int state) const;
+
+        /** Check whether Eve's strategy, recorded by `solve_parity_game`,
+            takes an out edge of an "even player" state of `exp`.
+
+            Every edge that leads to the same vertex as the strategy is
+            allowed, so several edges may be.
+
+            @param[in] edge The number of an out edge of an "even player" state of `exp`
+            @return true iff. Eve wins the state and may take the edge
+        */
+        bool eve_allows(const unsigned int edge) const;
+
         /** Overwrite the "state-names" named spot prop of the parity arena. */
         void set_state_names();
 
-        /** Throw a `std::runtime_error` iff. `clock() > this->deadline`. */
-        void assert_deadline() const;
+        /** Throw a `std::runtime_error` iff. `this->token` was cancelled.
+
+            This is a single relaxed atomic load, so it is cheap enough to
+            call from the innermost loops of the expansion and the solver.
+        */
+        void assert_deadline() const { this->token->check(); }
 
     private:
+        /** The solution of a previous game over the same expanded TwA, if any. */
+        std::vector<bool> seed_winners;
+        std::vector<int> seed_strategy;
+
+        /* Expand `src` into `exp`, reusing the states of `previous` if not null. */
+        void expand(const HOAxParityTwA *previous);
+
+        /* Copy the expansion of a state from `previous` iff. its out edges
+            are the same, and update `translate` for its edge numbers. */
+        bool reuse_state(const HOAxParityTwA &previous, const unsigned int state,
+                         std::vector<unsigned int> &translate);
+
+        /* Solve the bisimulation quotient of the arena, and map the winning
+            regions and strategies back to the arena. */
+        void solve_quotient(std::set<int> &W0, std::set<int> &W1) const;
+
+        /* Solve the arena renumbered in `options.order`, and map the winning
+            regions and strategies back to the original numbering. */
+        void solve_reordered(std::set<int> &W0, std::set<int> &W1) const;
+
+        /* Add the solver counters of a derived game to those of this game. */
+        void add_solver_stats(const hoax::Stats &derived) const;
+
+        /* Record the sizes of the TwAs, their named props, the BDDs and the
+            arena in the stats, see [memory.h](memory.h). */
+        void measure_memory() const;
+
+        /* Compute the state priorities and build the compact arena of `exp`. */
+        void build_arena();
+
+        /* Map the solution of `previous`, whose expanded TwA has the same
+            states and edges, onto the arena as the seed solution. */
+        void seed_from(const HOAxParityTwA &previous);
+
         /* Get the set of all state numbers. */
         std::set<int> get_all_states() const;
 
@@ -116,6 +295,28 @@ namespace hoax {
         const HOAxParityTwA &aut,
         const bool parity_max);
 
+    /** Zielonka's algorithm, with the priority index of the sub-game.
+
+        The index must hold exactly `vertices`. It is updated in place for
+        the recursive calls, and restored before returning. This runs the
+        `hoax::TreeSets` kernel, see `hoax::Kernel`.
+
+        @param[in] vertices All vertices to parition into W0 and W1.
+        @param[in] vertices_even Unused, the kernel reads the owners from the arena
+        @param[in] aut The parity game arena.
+        @param[in] parity_max If true, then solve for the "parity max" condition.
+                            Else solve for the "parity min" condition.
+        @param[in,out] index The priority index of `vertices`
+        @return See `hoax::zielonka` without an index.
+    */
+    std::tuple<std::set<int>, std::set<int>, unsigned int>
+    zielonka(
+        const std::set<int> &vertices,
+        const std::set<int> &vertices_even,
+        const HOAxParityTwA &aut,
+        const bool parity_max,
+        hoax::PriorityIndex &index);
+
     /** Compute the attractor set for the given player and arena.
 
         This is a loop-based implementation of the attractor set's recursive
@@ -129,9 +330,13 @@ namespace hoax {
                                 which to include in the attractor computation
         @param[in] vertices_odd The set of "odd player states" in the parity arena
                                 which to include in the attractor computation
-        @param[in] vertices_odd The set of "even player states" in the parity arena
-                                which to include in the attractor computation
-        @param[in] aut The parity arena
+        @param[in] vertices_even The set of "even player states" in the parity arena
+                                 which to include in the attractor computation
+        @param[in] aut The parity arena. For every attracted vertex of player
+                       `i`, the successor it is attracted through is written to
+                       `aut.strategy`, which must already hold an entry for
+                       every vertex, i.e. `aut.arena.num_states` entries, as
+                       `solve_parity_game` sizes it
         @param[in] T The vertices from which to start the attractor computation
         @param[in] i The player for whom to compute the attractor set
         @return The attractor set
@@ -145,17 +350,53 @@ namespace hoax {
         const std::set<int> &T,
         const unsigned int i);
 
+    /** Compute the attractor set for the given player and arena, on the
+        dense adjacency matrix `aut.dense`.
+
+        The sub-arena and the attractor are bitsets, so whether some resp. all
+        successors of a vertex in the sub-arena are attracted is decided by a
+        single pass of AND resp. ANDNOT over its adjacency row. Vertices are
+        added to the attractor as soon as they are found, so a round also
+        sees the vertices attracted earlier in the same round. This runs the
+        `hoax::BitSets` kernel, see `hoax::Kernel`.
+
+        @param[in] vertices_all The set of all states in the parity arena
+                                which to include in the attractor computation
+        @param[in] aut The parity arena, with a dense adjacency matrix, and
+                       `aut.strategy` sized as for `hoax::attractor`
+        @param[in] T The vertices from which to start the attractor computation
+        @param[in] i The player for whom to compute the attractor set
+        @return The attractor set, equal to that of `hoax::attractor`
+    */
+    std::set<int>
+    attractor_dense(
+        const std::set<int> &vertices_all,
+        const HOAxParityTwA &aut,
+        const std::set<int> &T,
+        const unsigned int i);
+
     /** The parity game priority function for a single edge.
 
         Each edge in spot specifies the acceptance sets of which it is a part.
         The priority function is derived from the acceptance set's indexes.
 
+        The priority is normalized, so that an even priority is good for
+        Eve regardless of the acceptance condition: for a "parity odd"
+        condition every priority is shifted up by one. An edge that is not
+        part of any acceptance set gets the least significant priority,
+        i.e. -1 for "parity max" and #sets for "parity min". This matches
+        spot's parity formulas, e.g. "parity min even 2" is `Inf(0) | Fin(1)`,
+        which accepts a run that sees no acceptance set infinitely often.
+
         @param[in] mark The acceptance sets membership bitvector of an edge
         @param[in] parity_max If true, then return the highest priority.
                               If false, then return the lowest priority.
+        @param[in] parity_odd If true, then the condition is "parity odd"
+        @param[in] num_sets The number of acceptance sets of the condition
         @return The edge priority value.
     */
-    int priority(const spot::acc_cond::mark_t &mark, const bool parity_max);
+    int priority(const spot::acc_cond::mark_t &mark, const bool parity_max,
+                 const bool parity_odd, const unsigned int num_sets);
 
     /** The parity game priority function for a single state.
 
@@ -167,9 +408,24 @@ namespace hoax {
         @param[in] state The state to compute the priority for.
         @param[in] parity_max If true, then return the highest priority.
                             If false, then return the lowest priority.
+        @param[in] parity_odd If true, then the condition is "parity odd"
+        @param[in] num_sets The number of acceptance sets of the condition
         @return The state priority value.
     */
-    int priority(const spot::twa_graph_ptr aut, const unsigned int state, const bool parity_max);
+    int priority(const spot::twa_graph_ptr aut, const unsigned int state, const bool parity_max,
+                 const bool parity_odd, const unsigned int num_sets);
+
+    /** Solve a game with spot's own synthesis, as a baseline for hoax.
+
+        In the expanded TwA the "odd player" picks the uncontrollable APs,
+        while spot's player 1 wins iff. the acceptance condition holds. So
+        this splits the source automaton with the controller as player 1
+        instead of solving `exp` with spot.
+
+        @param[in] aut The parity game to solve
+        @return True iff. the game is realizable, i.e. the controller wins
+    */
+    bool solve_spot(const spot::twa_graph_ptr aut);
 }
 
 #endif
\ No newline at end of file
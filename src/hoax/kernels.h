@@ -0,0 +1,463 @@
+#ifndef HOAX_KERNELS_H
+#define HOAX_KERNELS_H
+
+#include "hoax.h"
+#include "sets.h"
+#include "priority_index.h"
+#include <type_traits>
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+
+namespace hoax {
+
+    /** The solver core: Zielonka's algorithm, Parys' variant of it, and
+        their attractors, for a parity condition and a vertex set
+        representation that are both known at compile time.
+
+        `HOAxParityTwA::solve_parity_game` picks the instantiation once per
+        game, so the hot loops neither test the parity condition nor the
+        player, and a new set representation only needs a new policy, see
+        [sets.h](sets.h), instead of another copy of the algorithm.
+
+        The owner of every vertex is read from the arena, so unlike the
+        `std::set` based `hoax::zielonka`, the kernel needs no separate sets
+        of "even" and "odd" vertices.
+
+        @tparam Sets The vertex set policy, e.g. `hoax::TreeSets`
+        @tparam ParityMax If true, then the highest priority is the most
+                          significant one, else the lowest
+    */
+    template <typename Sets, bool ParityMax>
+    class Kernel {
+    public:
+        typedef typename Sets::Set Set;
+
+        /** @param[in] aut The parity game, whose strategy and stats the kernel updates */
+        explicit Kernel(const hoax::HOAxParityTwA &aut)
+            : aut(aut), arena(aut.arena), n(aut.arena.num_states), tracer(aut.options.tracer.get()) {}
+
+        /** Zielonka's algorithm, see `hoax::zielonka`.
+
+            @param[in] vertices The vertices of the sub-game
+            @param[in,out] index The priority index of exactly `vertices`
+            @return The tuple (W_i, W_(1-i), i) of the supported player i
+        */
+        std::tuple<Set, Set, unsigned int> zielonka(const Set &vertices, hoax::PriorityIndex &index) const {
+            this->aut.assert_deadline();
+            DepthGuard depth_guard(this->aut.stats);
+
+            /* The sizes are only computed for a recorded frame. */
+            hoax::TraceScope trace(this->tracer, "zielonka");
+            trace.arg("depth", this->aut.stats.zielonka_depth);
+            trace.arg("size", index.num_vertices());
+
+            /* Base case: no more vertices remain to be checked. */
+            if (index.empty())
+                return std::make_tuple(Sets::make(this->n), Sets::make(this->n), (unsigned int) PINVALID);
+
+            /* Support a player based on the extremum priority's parity. */
+            const int m = index.template extremum<ParityMax>();
+            const unsigned int player = std::abs(m) % 2;
+            const unsigned int player_other = 1 - player;
+            const Set M = Sets::from(index.template extremum_vertices<ParityMax>(), this->n);
+            trace.arg("priority", m);
+
+            Set R = this->attractor(vertices, M, player);
+            if (trace.enabled())
+                trace.arg("attractor", R.size());
+
+            /* If the supported player wins R, then they may move anywhere from
+                their vertices in M, as long as they stay in the sub-arena. */
+            for (const int vertex : M)
+                if (this->arena.owner(vertex) == (player == PODD))
+                    for (const uint32_t dst : this->arena.successors(vertex))
+                        if (Sets::contains(vertices, dst)) {
+                            this->aut.strategy[vertex] = dst;
+                            break;
+                        }
+
+            // Recursively solve for (G \ R)
+            index.erase(R);
+            auto [Wcurr_p1, Wprev_p1, player_rec_R] = this->zielonka(Sets::minus(vertices, R), index);
+            index.insert(R);
+            if (player_rec_R != player) std::swap(Wcurr_p1, Wprev_p1);
+
+            // The non-supported player cannot escape the attractor.
+            if (Sets::empty(Wprev_p1))
+                return std::make_tuple(Sets::unite(Wcurr_p1, R), Sets::make(this->n), player);
+
+            // The non-supported player can escape the attractor.
+            Set S = this->attractor(vertices, Wprev_p1, player_other);
+            if (trace.enabled())
+                trace.arg("escape", S.size());
+
+            // Recursively solve for (G \ S)
+            index.erase(S);
+            auto [Wcurr_p2, Wprev_p2, player_rec_S] = this->zielonka(Sets::minus(vertices, S), index);
+            index.insert(S);
+            if (player_rec_S != player) std::swap(Wcurr_p2, Wprev_p2);
+
+            return std::make_tuple(std::move(Wcurr_p2), Sets::unite(Wprev_p2, S), player);
+        }
+
+        /** Parys' quasi-polynomial variant of Zielonka's algorithm.
+
+            Like `zielonka`, a call removes the dominions of the opponent,
+            i.e. the sets from which the opponent wins without leaving them,
+            until none are left. It only looks for dominions up to a size,
+            its precision, though: the recursion first removes all small
+            dominions, of half the precision, then at most one large one,
+            and then the small ones again. Only the large call keeps the
+            precision, so there are n^O(log n) calls, instead of up to 2^d
+            for d priorities with Zielonka's algorithm.
+
+            The winning regions are exact, since the top call has the size
+            of the game as its precision. The recursion only finds dominions
+            though, so the strategies are computed afterwards, see
+            `parys_strategy`. Both stay quasi-polynomial.
+
+            @param[in] vertices The vertices of the sub-game
+            @param[in,out] index The priority index of exactly `vertices`
+            @return The tuple (W_i, W_(1-i), i) of the player i of the most
+                    significant priority
+        */
+        std::tuple<Set, Set, unsigned int> parys(const Set &vertices, hoax::PriorityIndex &index) const {
+            if (index.empty())
+                return std::make_tuple(Sets::make(this->n), Sets::make(this->n), (unsigned int) PINVALID);
+
+            const Levels levels = this->levels();
+            const unsigned int level = levels.of[index.template extremum_code<ParityMax>()];
+            const unsigned int player = levels.player[level];
+            const size_t size = index.num_vertices();
+            Set Wcurr = this->parys_solve(vertices, index, levels, level, size, size);
+            Set Wprev = Sets::minus(vertices, Wcurr);
+
+            index.erase(Wprev);
+            this->parys_strategy(Wcurr, index, levels, player);
+            index.insert(Wprev);
+            index.erase(Wcurr);
+            this->parys_strategy(Wprev, index, levels, 1 - player);
+            index.insert(Wcurr);
+            return std::make_tuple(std::move(Wcurr), std::move(Wprev), player);
+        }
+
+        /** The attractor of a player to T in a sub-game, see `hoax::attractor`.
+
+            Dispatches once on the player, so the rounds only test the owner
+            of every vertex against a constant.
+        */
+        Set attractor(const Set &vertices, const Set &T, const unsigned int i) const {
+            assert(i == PEVEN || i == PODD); // Avoid invalid player.
+            hoax::PerfScope perf(this->aut.stats.perf_attractor);
+            hoax::TraceScope trace(this->tracer, "attractor");
+            const uint64_t rounds = this->aut.stats.attractor_rounds;
+            Set attr = i == PODD ? this->attractor_of<true>(vertices, T) : this->attractor_of<false>(vertices, T);
+            if (trace.enabled()) {
+                trace.arg("depth", this->aut.stats.zielonka_depth);
+                trace.arg("player", i);
+                trace.arg("size", vertices.size());
+                trace.arg("target", T.size());
+                trace.arg("attractor", attr.size());
+                trace.arg("rounds", this->aut.stats.attractor_rounds - rounds);
+            }
+            return attr;
+        }
+
+    private:
+        const hoax::HOAxParityTwA &aut;
+        const hoax::Arena &arena;
+        const unsigned int n;
+        /** The tracer of the game, or null iff. tracing is disabled. */
+        hoax::Tracer *const tracer;
+
+        /* Track the recursion depth, also when unwinding through an exception. */
+        struct DepthGuard {
+            hoax::Stats &stats;
+            explicit DepthGuard(hoax::Stats &stats) : stats(stats) {
+                stats.zielonka_calls++;
+                stats.zielonka_depth_max = std::max(stats.zielonka_depth_max, ++stats.zielonka_depth);
+            }
+            ~DepthGuard() { stats.zielonka_depth--; }
+        };
+
+        /* The priorities grouped into levels, from the least to the most
+            significant one, such that consecutive levels belong to different
+            players. Parys' recursion descends one level per call. */
+        struct Levels {
+            /* The level of every priority code. */
+            std::vector<unsigned int> of;
+            /* The priority codes of every level. */
+            std::vector<std::vector<uint32_t>> codes;
+            /* The player of every level. */
+            std::vector<unsigned int> player;
+        };
+
+        Levels levels() const {
+            Levels levels;
+            const uint32_t num_codes = this->arena.num_priorities;
+            levels.of.resize(num_codes);
+            for (uint32_t i = 0; i < num_codes; i++) {
+                const uint32_t code = ParityMax ? i : num_codes - 1 - i;
+                const unsigned int player = std::abs(this->arena.priority_table[code]) % 2;
+                if (levels.player.empty() || levels.player.back() != player) {
+                    levels.player.push_back(player);
+                    levels.codes.emplace_back();
+                }
+                levels.of[code] = levels.player.size() - 1;
+                levels.codes.back().push_back(code);
+            }
+            return levels;
+        }
+
+        /* The vertices of the sub-game on a level. */
+        Set level_vertices(const hoax::PriorityIndex &index, const Levels &levels, const unsigned int level) const {
+            std::vector<int> vertices;
+            for (const uint32_t code : levels.codes[level]) {
+                const std::set<int> &bucket = index.vertices(code);
+                vertices.insert(vertices.end(), bucket.begin(), bucket.end());
+            }
+            if (levels.codes[level].size() > 1)
+                std::sort(vertices.begin(), vertices.end());
+            return Sets::from(vertices, this->n);
+        }
+
+        /* Parys' recursion for the player of the level, where the sub-game
+            has no more significant level. It returns the vertices left after
+            removing the dominions of the opponent, which contain every
+            dominion of the player of at most `precision` vertices, and no
+            dominion of the opponent of at most `precision_other` vertices.
+            So with both precisions at least the size of the sub-game, it
+            returns the exact winning region of the player. */
+        Set parys_solve(const Set &vertices, hoax::PriorityIndex &index, const Levels &levels,
+                        const int level, size_t precision, size_t precision_other) const {
+            this->aut.assert_deadline();
+            DepthGuard depth_guard(this->aut.stats);
+
+            hoax::TraceScope trace(this->tracer, "parys");
+            trace.arg("depth", this->aut.stats.zielonka_depth);
+            trace.arg("size", index.num_vertices());
+            trace.arg("level", level);
+            trace.arg("precision", precision);
+            trace.arg("precision_other", precision_other);
+
+            if (index.empty() || precision == 0)
+                return Sets::make(this->n);
+            assert(level >= 0);
+
+            /* A dominion of the sub-game is at most as large as the sub-game. */
+            precision = std::min(precision, index.num_vertices());
+            precision_other = std::min(precision_other, index.num_vertices());
+            const unsigned int player = levels.player[level];
+            const unsigned int player_other = 1 - player;
+
+            /* Without vertices on the level, the complement of what the
+                opponent keeps on the level below has both guarantees. */
+            bool empty = true;
+            for (const uint32_t code : levels.codes[level])
+                empty = empty && index.vertices(code).empty();
+            if (empty)
+                return Sets::minus(vertices, this->parys_solve(vertices, index, levels, level - 1,
+                                                               precision_other, precision));
+
+            /* Remove a dominion of the opponent of at most the given size, if
+                the recursion below the attractor of the level finds one. */
+            Set G = vertices;
+            Set removed = Sets::make(this->n);
+            size_t size_below = 0;
+            auto remove_dominion = [&](const size_t precision_rec) {
+                const Set N = this->level_vertices(index, levels, level);
+                Set A = Sets::empty(N) ? Sets::make(this->n) : this->attractor(G, N, player);
+                index.erase(A);
+                size_below = index.num_vertices();
+                Set W = this->parys_solve(Sets::minus(G, A), index, levels, level - 1, precision_rec, precision);
+                index.insert(A);
+                if (Sets::empty(W))
+                    return false;
+
+                Set S = this->attractor(G, W, player_other);
+                index.erase(S);
+                G = Sets::minus(G, S);
+                removed = Sets::unite(removed, S);
+                return true;
+            };
+
+            /* A call with the same sub-game and precisions finds the same
+                dominion, so the large call is skipped if the sub-game below
+                is no larger than the small precision, and the small calls
+                after it are skipped if it found nothing. */
+            const size_t precision_small = precision_other / 2;
+            while (remove_dominion(precision_small)) {}
+            if (precision_small < size_below && remove_dominion(precision_other))
+                while (remove_dominion(precision_small)) {}
+
+            index.insert(removed);
+            return G;
+        }
+
+        /* Record a winning strategy of a player that wins every vertex of the
+            sub-game, like `zielonka` does for its supported player. A level
+            of the player is attracted to and then left behind. For a level
+            of the opponent, the player wins some vertices of the sub-game
+            below its attractor, as else the opponent would win everything;
+            these are solved exactly, and their attractor is left behind. */
+        void parys_strategy(const Set &vertices, hoax::PriorityIndex &index, const Levels &levels,
+                            const unsigned int player) const {
+            Set G = vertices;
+            Set removed = Sets::make(this->n);
+            while (!index.empty()) {
+                const unsigned int level = levels.of[index.template extremum_code<ParityMax>()];
+                const Set N = this->level_vertices(index, levels, level);
+
+                Set S;
+                if (levels.player[level] == player) {
+                    S = this->attractor(G, N, player);
+                    for (const int vertex : N)
+                        if (this->arena.owner(vertex) == (player == PODD))
+                            for (const uint32_t dst : this->arena.successors(vertex))
+                                if (Sets::contains(G, dst)) {
+                                    this->aut.strategy[vertex] = dst;
+                                    break;
+                                }
+                } else {
+                    const Set A = this->attractor(G, N, 1 - player);
+                    index.erase(A);
+                    const Set H = Sets::minus(G, A);
+                    assert(!index.empty());
+                    const unsigned int level_below = levels.of[index.template extremum_code<ParityMax>()];
+                    const size_t size = index.num_vertices();
+                    Set W = this->parys_solve(H, index, levels, level_below, size, size);
+                    if (levels.player[level_below] != player)
+                        W = Sets::minus(H, W);
+                    assert(!Sets::empty(W));
+
+                    const Set rest = Sets::minus(H, W);
+                    index.erase(rest);
+                    this->parys_strategy(W, index, levels, player);
+                    index.insert(rest);
+                    index.insert(A);
+                    S = this->attractor(G, W, player);
+                }
+
+                index.erase(S);
+                G = Sets::minus(G, S);
+                removed = Sets::unite(removed, S);
+            }
+            index.insert(removed);
+        }
+
+        /* The attractor of the "odd player" iff. Odd, else of the "even player". */
+        template <bool Odd>
+        Set attractor_of(const Set &vertices, const Set &T) const {
+            this->aut.stats.attractor_calls++;
+
+            /* Every vertex of the player is attracted through a successor that
+                was attracted before it, so recording that successor as the
+                strategy makes progress towards T. Inserting into a bitset is
+                cheap, so it sees the vertices attracted earlier in the same
+                round; the other sets add the vertices found after the round. */
+            constexpr bool in_place = std::is_same<Sets, hoax::BitSets>::value;
+            Set attr = T;
+            std::vector<int> found;
+            while (true) {
+                this->aut.assert_deadline();
+                this->aut.stats.attractor_rounds++;
+                bool changed = false;
+
+                for (const int vertex : vertices) {
+                    if (Sets::contains(attr, vertex))
+                        continue;
+                    if (!this->attracted<Odd>(vertex, vertices, attr))
+                        continue;
+                    changed = true;
+                    if constexpr (in_place)
+                        attr.insert(vertex);
+                    else
+                        found.push_back(vertex);
+                }
+
+                /* Fixpoint reached, further iteration is redundant. */
+                if (!changed)
+                    return attr;
+                if constexpr (!in_place) {
+                    Sets::add(attr, found);
+                    found.clear();
+                }
+            }
+        }
+
+        /* Check whether the player can enter, resp. force the other player
+            into, the attractor from a vertex of the sub-game. */
+        template <bool Odd>
+        bool attracted(const int vertex, const Set &vertices, const Set &attr) const {
+            if constexpr (std::is_same<Sets, hoax::BitSets>::value) {
+                if (this->aut.dense != nullptr)
+                    return this->attracted_dense<Odd>(vertex, vertices, attr);
+            }
+
+            uint64_t edges_scanned = 0;
+            bool result;
+            if (this->arena.owner(vertex) == Odd) {
+                /* The player can choose to enter the attractor. */
+                result = false;
+                for (const uint32_t dst : this->arena.successors(vertex)) {
+                    /* We implicitly remove edges from the arena; exclude edges
+                        that are not part of the divide-and-conquer sub-arena. */
+                    if (!Sets::contains(vertices, dst))
+                        continue;
+                    edges_scanned++;
+                    if (Sets::contains(attr, dst)) {
+                        this->aut.strategy[vertex] = dst;
+                        result = true;
+                        break;
+                    }
+                }
+            } else {
+                /* The player forces the other player to enter the attractor. */
+                result = true;
+                for (const uint32_t dst : this->arena.successors(vertex)) {
+                    if (!Sets::contains(vertices, dst))
+                        continue;
+                    edges_scanned++;
+                    if (!Sets::contains(attr, dst)) {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+            this->aut.stats.edges_scanned += edges_scanned;
+            return result;
+        }
+
+        /* As `attracted`, on the adjacency row of the vertex: whether some
+            resp. all successors in the sub-game are attracted is a single
+            pass of AND resp. ANDNOT over whole words. */
+        template <bool Odd>
+        bool attracted_dense(const int vertex, const hoax::BitSet &vertices, const hoax::BitSet &attr) const {
+            const hoax::DenseArena &dense = *this->aut.dense;
+            const size_t words = dense.words();
+            const uint64_t *row = dense.row(vertex);
+            const uint64_t *sub = vertices.words.data();
+            const uint64_t *in = attr.words.data();
+            this->aut.stats.rows_scanned++;
+
+            if (this->arena.owner(vertex) == Odd) {
+                for (size_t w = 0; w < words; w++) {
+                    const uint64_t hits = row[w] & sub[w] & in[w];
+                    if (hits) {
+                        this->aut.strategy[vertex] = w * 64 + __builtin_ctzll(hits);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            uint64_t escapes = 0;
+            for (size_t w = 0; w < words; w++)
+                escapes |= row[w] & sub[w] & ~in[w];
+            return escapes == 0;
+        }
+    };
+}
+
+#endif
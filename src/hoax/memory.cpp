@@ -0,0 +1,138 @@
+#include "memory.h"
+#include <spot/twa/twagraph.hh>
+#include <bddx.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+
+#ifdef HOAX_ALLOC_COUNTERS
+#include <malloc.h>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    /** The heap allocations of the calling thread. It is constant
+        initialized, so `operator new` may use it before any constructor ran. */
+    thread_local hoax::AllocCounters thread_allocs;
+
+    void count_alloc(void *ptr) {
+        /* The usable size is what `operator delete` can find out again. */
+        const size_t size = malloc_usable_size(ptr);
+        thread_allocs.allocations++;
+        thread_allocs.bytes += size;
+        thread_allocs.live += size;
+        thread_allocs.live_peak = std::max(thread_allocs.live_peak, thread_allocs.live);
+    }
+
+    void count_free(void *ptr) {
+        if (ptr != nullptr)
+            thread_allocs.live -= malloc_usable_size(ptr);
+    }
+
+    void *counted_new(size_t size) {
+        if (size == 0)
+            size = 1;
+        void *ptr;
+        while ((ptr = std::malloc(size)) == nullptr) {
+            const std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+                throw std::bad_alloc();
+            handler();
+        }
+        count_alloc(ptr);
+        return ptr;
+    }
+
+    void counted_delete(void *ptr) noexcept {
+        count_free(ptr);
+        std::free(ptr);
+    }
+}
+
+/* Replace the global allocation functions, which spot, BuDDy's C++
+    wrappers and the standard containers all go through. The aligned
+    variants are left alone, so they are not counted. */
+void *operator new(size_t size) { return counted_new(size); }
+void *operator new[](size_t size) { return counted_new(size); }
+void *operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_new(size); } catch (...) { return nullptr; }
+}
+void *operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_new(size); } catch (...) { return nullptr; }
+}
+void operator delete(void *ptr) noexcept { counted_delete(ptr); }
+void operator delete[](void *ptr) noexcept { counted_delete(ptr); }
+void operator delete(void *ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete(void *ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+
+hoax::AllocCounters hoax::alloc_read() {
+    return thread_allocs;
+}
+
+int64_t hoax::alloc_exchange_peak(const int64_t peak) {
+    const int64_t previous = thread_allocs.live_peak;
+    thread_allocs.live_peak = peak;
+    return previous;
+}
+#endif
+
+uint64_t hoax::rss_bytes() {
+    /* The second field is the number of resident pages. */
+    std::FILE *file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+    unsigned long long size = 0, resident = 0;
+    const int fields = std::fscanf(file, "%llu %llu", &size, &resident);
+    std::fclose(file);
+    if (fields != 2)
+        return 0;
+    return uint64_t(resident) * sysconf(_SC_PAGESIZE);
+}
+
+uint64_t hoax::rss_peak_bytes() {
+    struct rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    /* Linux reports the peak in KiB. */
+    return uint64_t(usage.ru_maxrss) * 1024;
+}
+
+uint64_t hoax::bdd_bytes() {
+    /* BuDDy's node table only exists once a bdd_dict initialized it. */
+    if (!bdd_isrunning())
+        return 0;
+    return uint64_t(bdd_getallocnum()) * BDD_NODE_BYTES;
+}
+
+uint64_t hoax::arena_bytes(const hoax::Arena &arena) {
+    const uint64_t n = arena.num_states;
+    return (n + 1) * sizeof(uint32_t) +
+        uint64_t(arena.num_edges) * sizeof(uint32_t) +
+        (n + 63) / 64 * sizeof(uint64_t) +
+        uint64_t(arena.num_priorities) * sizeof(int32_t) +
+        n * arena.priority_width;
+}
+
+uint64_t hoax::twa_bytes(const spot::const_twa_graph_ptr &aut) {
+    const spot::twa_graph::graph_t &graph = aut->get_graph();
+    return graph.states().capacity() * sizeof(spot::twa_graph::graph_t::state_storage_t) +
+        graph.edge_vector().capacity() * sizeof(spot::twa_graph::graph_t::edge_storage_t);
+}
+
+hoax::MemoryScope::MemoryScope(hoax::MemoryCounters &field)
+    : field(field), rss_peak(hoax::rss_peak_bytes()), start(hoax::alloc_read()),
+      outer_peak(hoax::alloc_exchange_peak(this->start.live)) {}
+
+hoax::MemoryScope::~MemoryScope() {
+    const hoax::AllocCounters end = hoax::alloc_read();
+    this->field.rss = hoax::rss_bytes();
+    this->field.rss_growth += hoax::rss_peak_bytes() - this->rss_peak;
+    this->field.allocations += end.allocations - this->start.allocations;
+    this->field.bytes += end.bytes - this->start.bytes;
+    if (end.live_peak > this->start.live)
+        this->field.heap_peak = std::max(this->field.heap_peak, uint64_t(end.live_peak - this->start.live));
+    /* The peak of this scope is also a peak of the enclosing scope. */
+    hoax::alloc_exchange_peak(std::max(this->outer_peak, end.live_peak));
+}
@@ -0,0 +1,116 @@
+#ifndef HOAX_MEMORY_H
+#define HOAX_MEMORY_H
+
+#include "arena.h"
+#include <spot/twa/fwd.hh>
+#include <algorithm>
+#include <cstdint>
+
+namespace hoax {
+
+    /** The size in bytes of a node of BuDDy's node table: a packed
+        reference count and level, the low and high children, and the two
+        hash chain links. */
+    #define BDD_NODE_BYTES 20
+
+    /** The memory use of a phase, see `hoax::MemoryScope`. */
+    struct MemoryCounters {
+        /** The resident set size of the process at the end of the phase, in bytes. */
+        uint64_t rss = 0;
+        /** The growth of the peak resident set size of the process during
+            the phase, in bytes. It is 0 for a phase that fits into memory
+            that an earlier phase already touched. */
+        uint64_t rss_growth = 0;
+
+        /* Heap allocations of the calling thread iff. compiled in, see
+            `hoax::ALLOC_ENABLED`. */
+        /** The number of `operator new` calls. */
+        uint64_t allocations = 0;
+        /** The bytes allocated, including the allocations freed again. */
+        uint64_t bytes = 0;
+        /** The peak of the live heap bytes, above those live at the start of the phase. */
+        uint64_t heap_peak = 0;
+
+        /** Add the memory use of a later run of the same phase. */
+        void add(const MemoryCounters &other) {
+            this->rss = other.rss;
+            this->rss_growth += other.rss_growth;
+            this->allocations += other.allocations;
+            this->bytes += other.bytes;
+            this->heap_peak = std::max(this->heap_peak, other.heap_peak);
+        }
+    };
+
+    /** The heap allocations of a thread, counted by the replaced global
+        `operator new` and `operator delete`. */
+    struct AllocCounters {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        /** The bytes allocated and not yet freed. Memory that another
+            thread allocated and this thread frees makes it negative. */
+        int64_t live = 0;
+        /** The maximum of `live`, since the last `hoax::alloc_exchange_peak`. */
+        int64_t live_peak = 0;
+    };
+
+#ifdef HOAX_ALLOC_COUNTERS
+    /** True iff. the heap allocations are counted, see the meson option
+        "alloc_counters". */
+    constexpr bool ALLOC_ENABLED = true;
+
+    /** Read the heap allocation counts of the calling thread. */
+    AllocCounters alloc_read();
+
+    /** Set the peak live bytes of the calling thread.
+
+        @param[in] peak The new peak of the live bytes
+        @return The previous peak of the live bytes
+    */
+    int64_t alloc_exchange_peak(const int64_t peak);
+#else
+    constexpr bool ALLOC_ENABLED = false;
+
+    inline AllocCounters alloc_read() { return AllocCounters(); }
+    inline int64_t alloc_exchange_peak(const int64_t) { return 0; }
+#endif
+
+    /** Get the current resident set size of the process in bytes, from
+        "/proc/self/statm", or 0 if it is not available. */
+    uint64_t rss_bytes();
+
+    /** Get the peak resident set size of the process in bytes, see `getrusage`. */
+    uint64_t rss_peak_bytes();
+
+    /** Get the size in bytes of the nodes that BuDDy's node table has
+        allocated. The table is shared by all games of the process, and it
+        never shrinks. */
+    uint64_t bdd_bytes();
+
+    /** Get the size in bytes of the arrays of an arena. */
+    uint64_t arena_bytes(const hoax::Arena &arena);
+
+    /** Get the size in bytes of the state and edge vectors of a TwA,
+        including their unused capacity, but not of its named props. */
+    uint64_t twa_bytes(const spot::const_twa_graph_ptr &aut);
+
+    /** Add the memory use of a scope to a `hoax::Stats` field, like
+        `hoax::PhaseTimer` adds its wall time. Scopes may nest, since the
+        peak live bytes of the outer scope are restored when the inner one
+        ends. */
+    class MemoryScope {
+    public:
+        explicit MemoryScope(MemoryCounters &field);
+        ~MemoryScope();
+        MemoryScope(const MemoryScope&) = delete;
+        MemoryScope &operator=(const MemoryScope&) = delete;
+
+    private:
+        MemoryCounters &field;
+        const uint64_t rss_peak;
+        const AllocCounters start;
+        /** The peak live bytes of the enclosing scope. */
+        const int64_t outer_peak;
+    };
+}
+
+#endif
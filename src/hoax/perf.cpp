@@ -0,0 +1,100 @@
+#include "perf.h"
+
+#ifdef HOAX_PERF_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+
+/** The number of hardware events per thread. */
+#define PERF_NUM_EVENTS 4
+
+namespace {
+    /** The counter group of a thread: the cycles lead the group, so all
+        events are counted, and multiplexed, together. */
+    struct PerfGroup {
+        /** The file descriptor of every event, or -1 if it is not supported. */
+        int fds[PERF_NUM_EVENTS] = {-1, -1, -1, -1};
+        /** The position of every event in a read of the group, or -1. */
+        int slots[PERF_NUM_EVENTS] = {-1, -1, -1, -1};
+        unsigned int num_open = 0;
+
+        PerfGroup() {
+            const uint64_t llc_read_miss = PERF_COUNT_HW_CACHE_LL |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            const struct { uint32_t type; uint64_t config; } events[PERF_NUM_EVENTS] = {
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HW_CACHE, llc_read_miss},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            };
+            for (unsigned int i = 0; i < PERF_NUM_EVENTS; i++) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = events[i].type;
+                attr.config = events[i].config;
+                /* Only count user space, which needs the least privileges. */
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                    PERF_FORMAT_TOTAL_TIME_RUNNING;
+                /* The calling thread, on any CPU. */
+                this->fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, this->fds[0], 0);
+                /* Without a leader, there is no group to add the others to. */
+                if (this->fds[0] < 0)
+                    return;
+                if (this->fds[i] >= 0)
+                    this->slots[i] = this->num_open++;
+            }
+        }
+
+        ~PerfGroup() {
+            for (const int fd : this->fds)
+                if (fd >= 0)
+                    close(fd);
+        }
+
+        hoax::PerfCounters read() const {
+            hoax::PerfCounters counters;
+            if (this->fds[0] < 0)
+                return counters;
+
+            /* The number of events, the enabled and running times, then the
+                value of every event in the order they were opened. */
+            uint64_t data[3 + PERF_NUM_EVENTS];
+            if (::read(this->fds[0], data, sizeof(data)) < ssize_t(3 * sizeof(uint64_t)))
+                return counters;
+            const uint64_t enabled = data[1], running = data[2];
+            auto value = [&](const unsigned int event) -> uint64_t {
+                if (this->slots[event] < 0)
+                    return 0;
+                const uint64_t raw = data[3 + this->slots[event]];
+                /* Scale up the counts of a multiplexed group. */
+                if (running == 0 || running >= enabled)
+                    return raw;
+                return uint64_t(double(raw) * enabled / running);
+            };
+            counters.cycles = value(0);
+            counters.instructions = value(1);
+            counters.llc_misses = value(2);
+            counters.branch_misses = value(3);
+            return counters;
+        }
+    };
+
+    /** Get the counter group of the calling thread, opened on first use. */
+    const PerfGroup &thread_group() {
+        thread_local const PerfGroup group;
+        return group;
+    }
+}
+
+bool hoax::perf_available() {
+    return thread_group().fds[0] >= 0;
+}
+
+hoax::PerfCounters hoax::perf_read() {
+    return thread_group().read();
+}
+#endif
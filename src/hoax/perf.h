@@ -0,0 +1,80 @@
+#ifndef HOAX_PERF_H
+#define HOAX_PERF_H
+
+#include <cstdint>
+
+namespace hoax {
+
+    /** The hardware event counts of a phase, see `hoax::PerfScope`. */
+    struct PerfCounters {
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        /** The read misses of the last level cache. */
+        uint64_t llc_misses = 0;
+        uint64_t branch_misses = 0;
+
+        /** Add the counts of another phase to these counts. */
+        void add(const PerfCounters &other) {
+            this->cycles += other.cycles;
+            this->instructions += other.instructions;
+            this->llc_misses += other.llc_misses;
+            this->branch_misses += other.branch_misses;
+        }
+    };
+
+#ifdef HOAX_PERF_COUNTERS
+    /** True iff. the hardware counters are compiled in, see the meson
+        option "perf_counters". */
+    constexpr bool PERF_ENABLED = true;
+
+    /** Check whether the hardware counters of the calling thread could be
+        opened. Linux only counts them if `perf_event_open` is allowed,
+        i.e. "/proc/sys/kernel/perf_event_paranoid" is at most 2.
+    */
+    bool perf_available();
+
+    /** Read the user space event counts of the calling thread since its
+        counters were opened, or zeros if they are not available.
+
+        The counters are opened on the first read of every thread, and they
+        are scaled up if the kernel multiplexed them with other events.
+    */
+    PerfCounters perf_read();
+
+    /** Add the hardware event counts of a scope to a `hoax::Stats` field,
+        like `hoax::PhaseTimer` adds its wall time. Scopes may nest, e.g. the
+        attractors within zielonka. */
+    class PerfScope {
+    public:
+        explicit PerfScope(PerfCounters &field) : field(field), start(perf_read()) {}
+        ~PerfScope() {
+            const PerfCounters end = perf_read();
+            this->field.cycles += end.cycles - this->start.cycles;
+            this->field.instructions += end.instructions - this->start.instructions;
+            this->field.llc_misses += end.llc_misses - this->start.llc_misses;
+            this->field.branch_misses += end.branch_misses - this->start.branch_misses;
+        }
+        PerfScope(const PerfScope&) = delete;
+        PerfScope &operator=(const PerfScope&) = delete;
+
+    private:
+        PerfCounters &field;
+        const PerfCounters start;
+    };
+#else
+    constexpr bool PERF_ENABLED = false;
+
+    inline bool perf_available() { return false; }
+    inline PerfCounters perf_read() { return PerfCounters(); }
+
+    /* Compiled out: no system calls, and nothing left for the compiler. */
+    class PerfScope {
+    public:
+        explicit PerfScope(PerfCounters &) {}
+        PerfScope(const PerfScope&) = delete;
+        PerfScope &operator=(const PerfScope&) = delete;
+    };
+#endif
+}
+
+#endif
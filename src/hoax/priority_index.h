@@ -0,0 +1,133 @@
+#ifndef HOAX_PRIORITY_INDEX_H
+#define HOAX_PRIORITY_INDEX_H
+
+#include "arena.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <set>
+
+namespace hoax {
+
+    /** The vertices of a sub-game, bucketed by priority.
+
+        Every zielonka call needs the most significant priority `m` of its
+        sub-game and the set `M` of vertices with priority `m`. Scanning the
+        sub-game for both takes `O(n)` per call. The index keeps one bucket
+        per priority instead, so `m` takes `O(d)` for `d` distinct
+        priorities, and `M` is the bucket of `m`.
+
+        The index is updated, rather than rebuilt, when zielonka recurses into
+        a smaller sub-game: `erase` the removed vertices before the recursive
+        call, and `insert` them again after it returns. The vertices are
+        passed as any range of vertices, i.e. any of the solver's vertex sets,
+        see [sets.h](sets.h), or a braced list, which is a `std::set<int>`.
+    */
+    class PriorityIndex {
+    public:
+        /** Index the given vertices of an arena.
+
+            @param[in] arena The arena the vertices belong to
+            @param[in] vertices The vertices of the sub-game, in ascending order
+            @param[in] parity_max If true, then the highest priority is the
+                                  most significant one, else the lowest
+        */
+        template <typename Range = std::set<int>>
+        PriorityIndex(const hoax::Arena &arena, const Range &vertices, const bool parity_max)
+            : arena(arena), parity_max(parity_max), buckets(arena.num_priorities) {
+            /* The vertices are sorted, so every bucket is filled in order. */
+            for (const int vertex : vertices) {
+                std::set<int> &bucket = this->buckets[arena.priority_code(vertex)];
+                bucket.insert(bucket.end(), vertex);
+                this->size++;
+            }
+        }
+
+        /** True iff. the sub-game has no vertices. */
+        bool empty() const { return this->size == 0; }
+
+        /** The number of vertices of the sub-game. */
+        size_t num_vertices() const { return this->size; }
+
+        /** Get the most significant priority of the sub-game, for a parity
+            condition that is known at compile time.
+
+            @pre The sub-game is not empty.
+        */
+        template <bool ParityMax>
+        int extremum() const { return this->arena.priority_table[this->extremum_code<ParityMax>()]; }
+
+        /** Get the most significant priority of the sub-game.
+
+            @pre The sub-game is not empty.
+        */
+        int extremum() const { return this->parity_max ? this->extremum<true>() : this->extremum<false>(); }
+
+        /** Get the vertices of the sub-game with the most significant
+            priority, for a parity condition that is known at compile time.
+
+            @pre The sub-game is not empty.
+        */
+        template <bool ParityMax>
+        const std::set<int> &extremum_vertices() const { return this->buckets[this->extremum_code<ParityMax>()]; }
+
+        /** Get the vertices of the sub-game with the most significant priority.
+
+            @pre The sub-game is not empty.
+        */
+        const std::set<int> &extremum_vertices() const {
+            return this->parity_max ? this->extremum_vertices<true>() : this->extremum_vertices<false>();
+        }
+
+        /** Get the code of the most significant priority of the sub-game,
+            for a parity condition that is known at compile time.
+
+            @pre The sub-game is not empty.
+        */
+        template <bool ParityMax>
+        uint32_t extremum_code() const {
+            assert(!this->empty());
+            /* The priority table is sorted ascending. */
+            const uint32_t num_codes = this->buckets.size();
+            for (uint32_t i = 0; i < num_codes; i++) {
+                const uint32_t code = ParityMax ? num_codes - 1 - i : i;
+                if (!this->buckets[code].empty())
+                    return code;
+            }
+            return 0;
+        }
+
+        /** Get the vertices of the sub-game with the given priority code. */
+        const std::set<int> &vertices(const uint32_t code) const { return this->buckets[code]; }
+
+        /** Remove vertices from the sub-game; they must all be in it. */
+        template <typename Range = std::set<int>>
+        void erase(const Range &vertices) {
+            for (const int vertex : vertices) {
+                const size_t erased = this->buckets[this->arena.priority_code(vertex)].erase(vertex);
+                assert(erased == 1);
+                this->size -= erased;
+            }
+        }
+
+        /** Add vertices to the sub-game; none of them may be in it. */
+        template <typename Range = std::set<int>>
+        void insert(const Range &vertices) {
+            for (const int vertex : vertices) {
+                const bool inserted = this->buckets[this->arena.priority_code(vertex)].insert(vertex).second;
+                assert(inserted);
+                this->size += inserted;
+            }
+        }
+
+    private:
+        const hoax::Arena &arena;
+        const bool parity_max;
+        /** The vertices of every priority, indexed by priority code. */
+        std::vector<std::set<int>> buckets;
+        /** The total number of vertices in all buckets. */
+        size_t size = 0;
+    };
+}
+
+#endif
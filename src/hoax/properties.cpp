@@ -0,0 +1,50 @@
+#include "properties.h"
+
+std::string hoax::GameProperties::names() const {
+    std::string names;
+    auto add = [&names](const bool holds, const char *name) {
+        if (!holds)
+            return;
+        if (!names.empty())
+            names += ' ';
+        names += name;
+    };
+    add(this->state_acc, "state-acc");
+    add(this->deterministic, "deterministic");
+    add(this->complete, "complete");
+    return names;
+}
+
+hoax::GameProperties hoax::declared_properties(const spot::const_twa_graph_ptr &aut) {
+    hoax::GameProperties properties;
+    properties.state_acc = aut->prop_state_acc().is_true();
+    /* Spot marks a deterministic automaton as "universal", i.e. at most one
+        edge is enabled per evaluation, which only means deterministic if it
+        also has no universal edges, i.e. is "existential". */
+    properties.deterministic = aut->prop_universal().is_true() && aut->is_existential();
+    properties.complete = aut->prop_complete().is_true();
+    return properties;
+}
+
+std::string hoax::check_properties(const spot::const_twa_graph_ptr &aut, const hoax::GameProperties &properties) {
+    for (unsigned int state = 0; state < aut->num_states(); state++) {
+        /* The union of the guards seen so far, and the sets of the first edge. */
+        bdd covered = bddfalse;
+        bool first = true;
+        spot::acc_cond::mark_t acc;
+        for (auto &edge : aut->out(state)) {
+            if (properties.deterministic && (covered & edge.cond) != bddfalse)
+                return "deterministic";
+            covered |= edge.cond;
+
+            if (first)
+                acc = edge.acc;
+            else if (properties.state_acc && edge.acc != acc)
+                return "state-acc";
+            first = false;
+        }
+        if (properties.complete && covered != bddtrue)
+            return "complete";
+    }
+    return "";
+}
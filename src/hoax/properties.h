@@ -0,0 +1,53 @@
+#ifndef HOAX_PROPERTIES_H
+#define HOAX_PROPERTIES_H
+
+#include <spot/twa/twagraph.hh>
+#include <string>
+
+namespace hoax {
+
+    /** The guarantees of a game that the expansion and the priorities can
+        take shortcuts for, as declared by its HOA header, e.g.
+
+            properties: deterministic complete colored
+            State: 0 "vertex0" {0}
+
+        Spot keeps the declared `deterministic` and `complete` properties,
+        and marks an automaton as `state-acc` if its body puts the
+        acceptance sets on the states. Spot does not keep `colored`; the
+        shortcuts do not need it, since a state based colour already is a
+        single priority per state.
+    */
+    struct GameProperties {
+        /** All out edges of a state belong to the same acceptance sets. */
+        bool state_acc = false;
+        /** The guards of the out edges of a state are pairwise disjoint. */
+        bool deterministic = false;
+        /** The guards of the out edges of a state cover every evaluation. */
+        bool complete = false;
+
+        /** The names of the properties that hold, separated by spaces, e.g.
+            "state-acc deterministic". */
+        std::string names() const;
+    };
+
+    /** Read the properties that the HOA header of a game declared, as
+        parsed by spot. Nothing is checked; see `hoax::check_properties`.
+
+        @param[in] aut The parity game
+        @return The declared properties
+    */
+    GameProperties declared_properties(const spot::const_twa_graph_ptr &aut);
+
+    /** Check the declared properties of a game against its edges, in a
+        single pass over the out edges of every state.
+
+        @param[in] aut The parity game
+        @param[in] properties The declared properties of the game
+        @return The name of the first declared property that does not hold,
+                e.g. "deterministic", or the empty string iff. all hold
+    */
+    std::string check_properties(const spot::const_twa_graph_ptr &aut, const GameProperties &properties);
+}
+
+#endif
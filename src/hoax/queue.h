@@ -0,0 +1,73 @@
+#ifndef HOAX_QUEUE_H
+#define HOAX_QUEUE_H
+
+#include <condition_variable>
+#include <optional>
+#include <mutex>
+#include <deque>
+
+namespace hoax {
+
+    /** A blocking, bounded, multi-producer multi-consumer FIFO queue.
+
+        Producers block while the queue is full, which applies backpressure
+        to earlier pipeline stages and so bounds the number of items (e.g.
+        expanded arenas) alive at the same time.
+
+        Closing the queue signals the end of the stream: consumers drain
+        the remaining items, after which `pop` returns no value.
+    */
+    template <typename T>
+    class BoundedQueue {
+    public:
+        /** @param[in] capacity The maximum number of queued items, at least 1. */
+        explicit BoundedQueue(const size_t capacity) : capacity(capacity ? capacity : 1) {}
+
+        /** Push an item, blocking while the queue is full.
+
+            @return false iff. the queue was closed, and the item was dropped.
+        */
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->not_full.wait(lock, [this] { return this->closed || this->items.size() < this->capacity; });
+            if (this->closed)
+                return false;
+            this->items.push_back(std::move(item));
+            this->not_empty.notify_one();
+            return true;
+        }
+
+        /** Pop the oldest item, blocking while the queue is empty.
+
+            @return The item, or no value iff. the queue is closed and empty.
+        */
+        std::optional<T> pop() {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->not_empty.wait(lock, [this] { return this->closed || !this->items.empty(); });
+            if (this->items.empty())
+                return std::nullopt;
+            T item = std::move(this->items.front());
+            this->items.pop_front();
+            this->not_full.notify_one();
+            return item;
+        }
+
+        /** Close the queue; wake up all blocked producers and consumers. */
+        void close() {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->closed = true;
+            this->not_empty.notify_all();
+            this->not_full.notify_all();
+        }
+
+    private:
+        const size_t capacity;
+        bool closed = false;
+        std::deque<T> items;
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+    };
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include "quotient.h"
+#include <unordered_map>
+#include <algorithm>
+
+namespace {
+    /** Hashes a signature, i.e. a class followed by its sorted successor classes. */
+    struct SignatureHash {
+        size_t operator()(const std::vector<uint32_t> &signature) const {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (const uint32_t c : signature) {
+                hash ^= c;
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+    };
+}
+
+hoax::Quotient hoax::bisimulation_quotient(const hoax::Arena &arena,
+                                           const std::shared_ptr<const hoax::CancelToken> &token) {
+    const unsigned int n = arena.num_states;
+    hoax::Quotient quotient;
+    std::vector<uint32_t> &class_of = quotient.class_of;
+    class_of.resize(n);
+
+    /* The initial partition by owner and priority. */
+    uint32_t num_classes = 0;
+    {
+        std::unordered_map<int64_t, uint32_t> classes;
+        for (uint32_t v = 0; v < n; v++) {
+            const int64_t key = int64_t(arena.priority(v)) * 2 + arena.owner(v);
+            auto [it, inserted] = classes.emplace(key, num_classes);
+            num_classes += inserted;
+            class_of[v] = it->second;
+        }
+    }
+
+    /* Refine until a round splits no class. A class only ever splits, so
+        an unchanged number of classes means an unchanged partition. */
+    std::vector<uint32_t> next(n);
+    std::vector<uint32_t> signature;
+    std::unordered_map<std::vector<uint32_t>, uint32_t, SignatureHash> classes;
+    while (true) {
+        token->check();
+        classes.clear();
+        uint32_t num_next = 0;
+        for (uint32_t v = 0; v < n; v++) {
+            signature.assign(1, class_of[v]);
+            for (const uint32_t dst : arena.successors(v))
+                signature.push_back(class_of[dst]);
+            std::sort(signature.begin() + 1, signature.end());
+            signature.erase(std::unique(signature.begin() + 1, signature.end()), signature.end());
+
+            auto [it, inserted] = classes.emplace(signature, num_next);
+            num_next += inserted;
+            next[v] = it->second;
+        }
+        class_of.swap(next);
+        if (num_next == num_classes)
+            break;
+        num_classes = num_next;
+    }
+
+    /* Every member of a class has the same successor classes, so the first
+        member represents the class. */
+    std::vector<uint32_t> representative(num_classes, UINT32_MAX);
+    for (uint32_t v = 0; v < n; v++)
+        if (representative[class_of[v]] == UINT32_MAX)
+            representative[class_of[v]] = v;
+
+    std::vector<uint32_t> offsets(num_classes + 1, 0);
+    std::vector<uint32_t> targets;
+    std::vector<bool> owners(num_classes);
+    std::vector<int> priorities(num_classes);
+    for (uint32_t c = 0; c < num_classes; c++) {
+        const uint32_t v = representative[c];
+        owners[c] = arena.owner(v);
+        priorities[c] = arena.priority(v);
+
+        const size_t first = targets.size();
+        for (const uint32_t dst : arena.successors(v))
+            targets.push_back(class_of[dst]);
+        std::sort(targets.begin() + first, targets.end());
+        targets.erase(std::unique(targets.begin() + first, targets.end()), targets.end());
+        offsets[c + 1] = targets.size();
+    }
+
+    quotient.arena = hoax::make_arena(std::move(offsets), std::move(targets), owners, priorities,
+                                      class_of[arena.init_state], arena.parity_max,
+                                      arena.parity_odd, arena.num_sets);
+    return quotient;
+}
@@ -0,0 +1,44 @@
+#ifndef HOAX_QUOTIENT_H
+#define HOAX_QUOTIENT_H
+
+#include "arena.h"
+#include "cancel.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hoax {
+
+    /** The quotient of an arena, and the class of every original vertex. */
+    struct Quotient {
+        /** The quotient arena, with one vertex per equivalence class. */
+        hoax::Arena arena;
+        /** The quotient vertex, i.e. the class, of every original vertex. */
+        std::vector<uint32_t> class_of;
+    };
+
+    /** Compute the quotient of an arena under owner and priority respecting
+        bisimulation.
+
+        Two vertices are equivalent iff. they have the same owner, the same
+        priority, and their successors fall into the same set of classes. The
+        expansion creates many such vertices, one per (state, evaluation),
+        e.g. every evaluation of an AP that a state does not care about.
+
+        The classes are found by partition refinement: starting from the
+        partition by (owner, priority), every round splits the classes by the
+        set of classes of their successors, until no class splits anymore.
+
+        Bisimilar vertices have the same winner, and a positional strategy
+        on the quotient maps back to the arena: move to any successor in the
+        class that the strategy of the quotient moves to.
+
+        @param[in] arena The arena to reduce
+        @param[in] token If this token is cancelled, then quit early
+        @return The quotient arena and the class of every vertex
+    */
+    Quotient bisimulation_quotient(const hoax::Arena &arena,
+                                   const std::shared_ptr<const hoax::CancelToken> &token);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#include "reorder.h"
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+
+/** A vertex number that was not assigned yet. */
+const uint32_t VERTEX_UNNUMBERED = UINT32_MAX;
+
+/** Order the vertices breadth-first from the initial vertex.
+
+    @param[in] arena The arena to order
+    @param[in] undirected If true, then also follow the edges backwards, and
+                          visit the neighbors of a vertex by increasing
+                          degree, i.e. Cuthill-McKee
+    @return The original number of every new vertex
+*/
+static std::vector<uint32_t> breadth_first(const hoax::Arena &arena, const bool undirected) {
+    const unsigned int n = arena.num_states;
+
+    /* The predecessors of every vertex in CSR form, only if undirected. */
+    std::vector<uint32_t> pred_offsets, pred_sources;
+    if (undirected) {
+        pred_offsets.assign(n + 1, 0);
+        for (uint32_t e = 0; e < arena.num_edges; e++)
+            pred_offsets[arena.targets[e] + 1]++;
+        std::partial_sum(pred_offsets.begin(), pred_offsets.end(), pred_offsets.begin());
+        pred_sources.resize(arena.num_edges);
+        std::vector<uint32_t> fill(pred_offsets.begin(), pred_offsets.end() - 1);
+        for (uint32_t v = 0; v < n; v++)
+            for (const uint32_t dst : arena.successors(v))
+                pred_sources[fill[dst]++] = v;
+    }
+    auto degree = [&](const uint32_t v) {
+        return arena.offsets[v + 1] - arena.offsets[v] + pred_offsets[v + 1] - pred_offsets[v];
+    };
+
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+    std::vector<uint32_t> neighbors;
+    /* Start at the initial vertex, then at every vertex that is still unvisited. */
+    for (uint32_t i = 0; i <= n; i++) {
+        const uint32_t root = i == 0 ? arena.init_state : i - 1;
+        if (root >= n || visited[root])
+            continue;
+        /* The order itself is the BFS queue. */
+        size_t head = order.size();
+        visited[root] = true;
+        order.push_back(root);
+        for (; head < order.size(); head++) {
+            const uint32_t v = order[head];
+            neighbors.assign(arena.successors(v).begin(), arena.successors(v).end());
+            if (undirected) {
+                neighbors.insert(neighbors.end(), pred_sources.begin() + pred_offsets[v],
+                                 pred_sources.begin() + pred_offsets[v + 1]);
+                std::stable_sort(neighbors.begin(), neighbors.end(), [&](const uint32_t a, const uint32_t b) {
+                    return degree(a) < degree(b);
+                });
+            }
+            for (const uint32_t w : neighbors)
+                if (!visited[w]) {
+                    visited[w] = true;
+                    order.push_back(w);
+                }
+        }
+    }
+    return order;
+}
+
+hoax::VertexOrder hoax::parse_vertex_order(const std::string &name) {
+    if (name == "none")
+        return hoax::ORDER_NONE;
+    if (name == "bfs")
+        return hoax::ORDER_BFS;
+    if (name == "rcm")
+        return hoax::ORDER_RCM;
+    if (name == "priority")
+        return hoax::ORDER_PRIORITY;
+    throw std::runtime_error("Unknown vertex order \"" + name + "\", expected none, bfs, rcm or priority");
+}
+
+hoax::Reordering hoax::reorder_arena(const hoax::Arena &arena, const hoax::VertexOrder order) {
+    const unsigned int n = arena.num_states;
+    hoax::Reordering reordering;
+    std::vector<uint32_t> &old_of = reordering.old_of;
+
+    switch (order) {
+        case hoax::ORDER_BFS:
+            old_of = breadth_first(arena, false);
+            break;
+        case hoax::ORDER_RCM:
+            old_of = breadth_first(arena, true);
+            std::reverse(old_of.begin(), old_of.end());
+            break;
+        case hoax::ORDER_PRIORITY:
+            old_of.resize(n);
+            std::iota(old_of.begin(), old_of.end(), 0);
+            std::stable_sort(old_of.begin(), old_of.end(), [&](const uint32_t a, const uint32_t b) {
+                const uint32_t pa = arena.priority_code(a), pb = arena.priority_code(b);
+                return pa != pb ? pa < pb : arena.owner(a) < arena.owner(b);
+            });
+            break;
+        default:
+            old_of.resize(n);
+            std::iota(old_of.begin(), old_of.end(), 0);
+            break;
+    }
+
+    std::vector<uint32_t> &new_of = reordering.new_of;
+    new_of.assign(n, VERTEX_UNNUMBERED);
+    for (uint32_t v = 0; v < n; v++)
+        new_of[old_of[v]] = v;
+
+    std::vector<uint32_t> offsets(n + 1, 0);
+    std::vector<uint32_t> targets;
+    targets.reserve(arena.num_edges);
+    std::vector<bool> owners(n);
+    std::vector<int> priorities(n);
+    for (uint32_t v = 0; v < n; v++) {
+        const uint32_t old = old_of[v];
+        owners[v] = arena.owner(old);
+        priorities[v] = arena.priority(old);
+
+        const size_t first = targets.size();
+        for (const uint32_t dst : arena.successors(old))
+            targets.push_back(new_of[dst]);
+        std::sort(targets.begin() + first, targets.end());
+        offsets[v + 1] = targets.size();
+    }
+
+    reordering.arena = hoax::make_arena(std::move(offsets), std::move(targets), owners, priorities,
+                                        new_of[arena.init_state], arena.parity_max,
+                                        arena.parity_odd, arena.num_sets);
+    return reordering;
+}
@@ -0,0 +1,65 @@
+#ifndef HOAX_REORDER_H
+#define HOAX_REORDER_H
+
+#include "arena.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hoax {
+
+    /** The vertex orders of `hoax::reorder_arena`. */
+    enum VertexOrder : int {
+        /** Keep the construction order of the expansion. */
+        ORDER_NONE = 0,
+        /** Breadth-first order from the initial vertex. */
+        ORDER_BFS = 1,
+        /** Reverse Cuthill-McKee order from the initial vertex. */
+        ORDER_RCM = 2,
+        /** Group the vertices by priority, then by owner. */
+        ORDER_PRIORITY = 3,
+    };
+
+    /** Parse the name of a vertex order, i.e. "none", "bfs", "rcm" or "priority".
+
+        @param[in] name The name of the vertex order
+        @return The vertex order
+        @throw std::runtime_error If the name is unknown
+    */
+    VertexOrder parse_vertex_order(const std::string &name);
+
+    /** An arena with renumbered vertices, and the mapping between both numberings. */
+    struct Reordering {
+        /** The renumbered arena. */
+        hoax::Arena arena;
+        /** The new number of every original vertex. */
+        std::vector<uint32_t> new_of;
+        /** The original number of every new vertex, i.e. the inverse of `new_of`. */
+        std::vector<uint32_t> old_of;
+    };
+
+    /** Renumber the vertices of an arena to improve the locality of its edges.
+
+        The expansion appends the "even player" vertices of a state after all
+        source states, so the successors of a vertex are spread all over the
+        arena. Renumbering the vertices in BFS or reverse Cuthill-McKee order
+        places most successors close to their predecessors, so the scans of
+        the attractors hit the cache far more often. Grouping by priority
+        instead keeps the vertices that zielonka removes together close.
+
+        The BFS order starts at the initial vertex. The vertices it does not
+        reach get their own BFS trees afterwards, each rooted at the
+        unvisited vertex with the lowest original number. RCM builds the
+        Cuthill-McKee order the same way, following the edges in both
+        directions, and then reverses it as a whole, so the initial vertex
+        comes last. The priority order does not depend on reachability. The
+        successors of every vertex are sorted by their new number.
+
+        @param[in] arena The arena to renumber
+        @param[in] order The order of the new numbering
+        @return The renumbered arena and the mapping between both numberings
+    */
+    Reordering reorder_arena(const hoax::Arena &arena, const VertexOrder order);
+}
+
+#endif
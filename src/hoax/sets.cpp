@@ -0,0 +1,14 @@
+#include "sets.h"
+#include <stdexcept>
+
+hoax::SetPolicy hoax::parse_set_policy(const std::string &name) {
+    if (name == "auto")
+        return hoax::SETS_AUTO;
+    if (name == "tree")
+        return hoax::SETS_TREE;
+    if (name == "vector")
+        return hoax::SETS_VECTOR;
+    if (name == "bitset")
+        return hoax::SETS_BITSET;
+    throw std::runtime_error("Unknown set representation \"" + name + "\", expected auto, tree, vector or bitset");
+}
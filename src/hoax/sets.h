@@ -0,0 +1,184 @@
+#ifndef HOAX_SETS_H
+#define HOAX_SETS_H
+
+#include "utils.h"
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <set>
+
+namespace hoax {
+
+    /** The vertex set representations of the solver kernels, see `hoax::Kernel`. */
+    enum SetPolicy : int {
+        /** Choose the representation from the arena size. */
+        SETS_AUTO = 0,
+        /** Balanced trees, i.e. `std::set<int>`; see `hoax::TreeSets`. */
+        SETS_TREE = 1,
+        /** Sorted vectors; see `hoax::VectorSets`. */
+        SETS_VECTOR = 2,
+        /** Bitsets over all vertices; see `hoax::BitSets`. */
+        SETS_BITSET = 3,
+    };
+
+    /** Parse the name of a set representation, i.e. "auto", "tree", "vector" or "bitset".
+
+        @param[in] name The name of the set representation
+        @return The set representation
+        @throw std::runtime_error If the name is unknown
+    */
+    SetPolicy parse_set_policy(const std::string &name);
+
+    /** A set of vertices as a bitset over all vertices of an arena. */
+    class BitSet {
+    public:
+        /** Iterates the vertices of the set in ascending order. */
+        class const_iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef int value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const int *pointer;
+            typedef int reference;
+
+            const_iterator(const uint64_t *words, const size_t num_words, const size_t word)
+                : words(words), num_words(num_words), word(word), bits(word < num_words ? words[word] : 0) {
+                this->skip_empty();
+            }
+            int operator*() const { return int(this->word * 64 + __builtin_ctzll(this->bits)); }
+            const_iterator &operator++() {
+                this->bits &= this->bits - 1;
+                this->skip_empty();
+                return *this;
+            }
+            bool operator==(const const_iterator &other) const { return this->word == other.word && this->bits == other.bits; }
+            bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+        private:
+            const uint64_t *words;
+            size_t num_words;
+            size_t word;
+            uint64_t bits;
+
+            /* Move to the next word with a set bit, or to the end. */
+            void skip_empty() {
+                while (this->bits == 0 && ++this->word < this->num_words)
+                    this->bits = this->words[this->word];
+                if (this->bits == 0)
+                    this->word = this->num_words;
+            }
+        };
+
+        BitSet() = default;
+        /** An empty set over the vertices [0, n). */
+        explicit BitSet(const size_t n) : words((n + 63) / 64, 0) {}
+
+        bool contains(const uint32_t v) const { return (this->words[v >> 6] >> (v & 63)) & 1; }
+        void insert(const uint32_t v) { this->words[v >> 6] |= uint64_t(1) << (v & 63); }
+        bool empty() const {
+            for (const uint64_t word : this->words)
+                if (word != 0)
+                    return false;
+            return true;
+        }
+        size_t size() const {
+            size_t count = 0;
+            for (const uint64_t word : this->words)
+                count += __builtin_popcountll(word);
+            return count;
+        }
+        const_iterator begin() const { return const_iterator(this->words.data(), this->words.size(), 0); }
+        const_iterator end() const { return const_iterator(this->words.data(), this->words.size(), this->words.size()); }
+        bool operator==(const BitSet &other) const { return this->words == other.words; }
+
+        /** The 64 bit words of the set, bit `v & 63` of word `v >> 6` for vertex `v`. */
+        std::vector<uint64_t> words;
+    };
+
+    /* The set policies. Every policy provides a `Set` type, which is a range
+        of its vertices in ascending order, and the few set operations that
+        the solver kernels need. Sets are over the vertices [0, n) of an arena. */
+
+    /** Vertex sets as balanced trees. Cheap for small sub-games of large arenas. */
+    struct TreeSets {
+        typedef std::set<int> Set;
+
+        static Set make(const unsigned int) { return Set(); }
+        template <typename Range>
+        static Set from(const Range &range, const unsigned int) { return Set(range.begin(), range.end()); }
+        static bool contains(const Set &s, const int v) { return s.find(v) != s.end(); }
+        static bool empty(const Set &s) { return s.empty(); }
+        /** Add vertices, given in ascending order. */
+        static void add(Set &s, const std::vector<int> &vertices) {
+            for (const int v : vertices)
+                s.insert(v);
+        }
+        static Set minus(const Set &s1, const Set &s2) { return hoax::operator-(s1, s2); }
+        static Set unite(Set &s1, Set &s2) { return std::move(hoax::merge(s1, s2)); }
+    };
+
+    /** Vertex sets as sorted vectors. Compact, with linear time set operations. */
+    struct VectorSets {
+        typedef std::vector<int> Set;
+
+        static Set make(const unsigned int) { return Set(); }
+        template <typename Range>
+        static Set from(const Range &range, const unsigned int) { return Set(range.begin(), range.end()); }
+        static bool contains(const Set &s, const int v) { return std::binary_search(s.begin(), s.end(), v); }
+        static bool empty(const Set &s) { return s.empty(); }
+        static void add(Set &s, const std::vector<int> &vertices) {
+            const size_t middle = s.size();
+            s.insert(s.end(), vertices.begin(), vertices.end());
+            std::inplace_merge(s.begin(), s.begin() + middle, s.end());
+        }
+        static Set minus(const Set &s1, const Set &s2) {
+            Set result;
+            result.reserve(s1.size());
+            std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(), std::back_inserter(result));
+            return result;
+        }
+        static Set unite(Set &s1, Set &s2) {
+            Set result;
+            result.reserve(s1.size() + s2.size());
+            std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(), std::back_inserter(result));
+            return result;
+        }
+    };
+
+    /** Vertex sets as bitsets. Constant time membership, and word-wise set
+        operations, at the cost of `n / 64` words per set. */
+    struct BitSets {
+        typedef hoax::BitSet Set;
+
+        static Set make(const unsigned int n) { return Set(n); }
+        template <typename Range>
+        static Set from(const Range &range, const unsigned int n) {
+            Set s(n);
+            for (const int v : range)
+                s.insert(v);
+            return s;
+        }
+        static bool contains(const Set &s, const int v) { return s.contains(v); }
+        static bool empty(const Set &s) { return s.empty(); }
+        static void add(Set &s, const std::vector<int> &vertices) {
+            for (const int v : vertices)
+                s.insert(v);
+        }
+        static Set minus(const Set &s1, const Set &s2) {
+            Set result = s1;
+            for (size_t w = 0; w < result.words.size(); w++)
+                result.words[w] &= ~s2.words[w];
+            return result;
+        }
+        static Set unite(Set &s1, Set &s2) {
+            Set result = std::move(s1);
+            for (size_t w = 0; w < result.words.size(); w++)
+                result.words[w] |= s2.words[w];
+            return result;
+        }
+    };
+}
+
+#endif
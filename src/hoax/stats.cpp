@@ -0,0 +1,114 @@
+#include "stats.h"
+#include <sstream>
+#include <iomanip>
+
+std::string hoax::Stats::to_json(const std::string &path_in, const std::string &result,
+                                 const unsigned int num_states, const unsigned int num_edges) const {
+    std::ostringstream os;
+    os << std::setprecision(6) << std::fixed;
+    os << "{\"file\": " << hoax::json_string(path_in)
+       << ", \"result\": " << hoax::json_string(result)
+       << ", \"time\": {"
+       << "\"parse\": " << this->time_parse
+       << ", \"expand\": " << this->time_expand
+       << ", \"priority\": " << this->time_priority
+       << ", \"solve\": " << this->time_solve
+       << ", \"reduce\": " << this->time_reduce
+       << ", \"export\": " << this->time_export
+       << ", \"check\": " << this->time_check
+       << ", \"queue\": " << this->time_queue
+       << ", \"total\": " << (this->time_parse + this->time_expand + this->time_priority + this->time_solve +
+                               this->time_export + this->time_check)
+       << "}";
+    if (hoax::PERF_ENABLED) {
+        /* Write the counts of a phase as a JSON object. */
+        auto perf = [&os](const char *phase, const hoax::PerfCounters &counters) {
+            os << "\"" << phase << "\": {"
+               << "\"cycles\": " << counters.cycles
+               << ", \"instructions\": " << counters.instructions
+               << ", \"llc_misses\": " << counters.llc_misses
+               << ", \"branch_misses\": " << counters.branch_misses
+               << "}";
+        };
+        os << ", \"perf\": {\"available\": " << (hoax::perf_available() ? "true" : "false") << ", ";
+        perf("parse", this->perf_parse);
+        os << ", ";
+        perf("expand", this->perf_expand);
+        os << ", ";
+        perf("priority", this->perf_priority);
+        os << ", ";
+        perf("zielonka", this->perf_zielonka);
+        os << ", ";
+        perf("attractor", this->perf_attractor);
+        os << "}";
+    }
+    /* Write the memory use of a phase as a JSON object. */
+    auto memory = [&os](const char *phase, const hoax::MemoryCounters &counters) {
+        os << "\"" << phase << "\": {"
+           << "\"rss\": " << counters.rss
+           << ", \"rss_growth\": " << counters.rss_growth;
+        if (hoax::ALLOC_ENABLED)
+            os << ", \"allocations\": " << counters.allocations
+               << ", \"bytes\": " << counters.bytes
+               << ", \"heap_peak\": " << counters.heap_peak;
+        os << "}, ";
+    };
+    os << ", \"memory\": {\"rss_peak\": " << hoax::rss_peak_bytes() << ", ";
+    memory("parse", this->memory_parse);
+    memory("expand", this->memory_expand);
+    memory("priority", this->memory_priority);
+    memory("solve", this->memory_solve);
+    os << "\"source\": " << this->bytes_source
+       << ", \"expansion\": " << this->bytes_expansion
+       << ", \"named_props\": " << this->bytes_named_props
+       << ", \"arena\": " << this->bytes_arena
+       << ", \"bdd\": " << this->bytes_bdd
+       << "}";
+    os << ", \"arena\": {"
+       << "\"states\": " << num_states
+       << ", \"edges\": " << num_edges
+       << "}, \"engine\": " << hoax::json_string(this->engine)
+       << ", \"properties\": " << hoax::json_string(this->properties)
+       << ", \"certificate\": " << hoax::json_string(this->certificate)
+       << ", \"estimate\": {"
+       << "\"states\": " << this->estimated_states
+       << ", \"edges\": " << this->estimated_edges
+       << ", \"bytes\": " << this->estimated_bytes
+       << "}, \"expansion\": {"
+       << "\"eve_states\": " << this->eve_states
+       << ", \"evals_skipped\": " << this->evals_skipped
+       << ", \"eve_contracted\": " << this->eve_contracted
+       << ", \"edge_vertices\": " << this->edge_vertices
+       << ", \"states_reused\": " << this->states_reused
+       << "}, \"solver\": {"
+       << "\"quotient_states\": " << this->quotient_states
+       << ", \"zielonka_calls\": " << this->zielonka_calls
+       << ", \"zielonka_depth_max\": " << this->zielonka_depth_max
+       << ", \"attractor_calls\": " << this->attractor_calls
+       << ", \"attractor_rounds\": " << this->attractor_rounds
+       << ", \"edges_scanned\": " << this->edges_scanned
+       << ", \"rows_scanned\": " << this->rows_scanned
+       << ", \"warm_start\": " << (this->warm_start ? "true" : "false")
+       << "}}";
+    return os.str();
+}
+
+std::string hoax::json_string(const std::string &s) {
+    std::ostringstream os;
+    os << '"';
+    for (const unsigned char c : s) {
+        switch (c) {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if (c < 0x20)
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec;
+                else
+                    os << c;
+        }
+    }
+    os << '"';
+    return os.str();
+}
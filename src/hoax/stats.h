@@ -0,0 +1,133 @@
+#ifndef HOAX_STATS_H
+#define HOAX_STATS_H
+
+#include <cstdint>
+#include <string>
+#include "cancel.h"
+#include "perf.h"
+#include "memory.h"
+
+namespace hoax {
+
+    /** Per game instrumentation: wall time per phase and work counters.
+
+        The counters are plain integers that are bumped from the innermost
+        loops of the expansion and the solver, so they are always collected.
+        Only their output is optional.
+    */
+    struct Stats {
+        /* Wall clock time per phase, in seconds. */
+        double time_parse = 0;
+        double time_expand = 0;
+        double time_priority = 0;
+        double time_solve = 0;
+        /** The part of `time_solve` spent on reducing and renumbering the arena. */
+        double time_reduce = 0;
+        /** The time spent on exporting the arena, see `hoax::export_arena`. */
+        double time_export = 0;
+        /** The time spent on checking the solution, see `hoax::check_solution`. */
+        double time_check = 0;
+        /** The time the game waited for the solver in pipeline mode, which
+            does not count towards its runtime budget nor its total time. */
+        double time_queue = 0;
+
+        /* Hardware event counts per phase, iff. compiled in, see `hoax::PerfScope`.
+            The zielonka counts include those of its attractors. */
+        hoax::PerfCounters perf_parse;
+        hoax::PerfCounters perf_expand;
+        hoax::PerfCounters perf_priority;
+        hoax::PerfCounters perf_zielonka;
+        hoax::PerfCounters perf_attractor;
+
+        /* Memory use per phase, see `hoax::MemoryScope`. */
+        hoax::MemoryCounters memory_parse;
+        hoax::MemoryCounters memory_expand;
+        hoax::MemoryCounters memory_priority;
+        hoax::MemoryCounters memory_solve;
+
+        /* The size in bytes of the data structures of the game. */
+        /** The source TwA, see `hoax::twa_bytes`. */
+        uint64_t bytes_source = 0;
+        /** The expanded TwA, see `hoax::twa_bytes`. */
+        uint64_t bytes_expansion = 0;
+        /** The named props of the expanded TwA that HOAx sets. */
+        uint64_t bytes_named_props = 0;
+        /** The arena, see `hoax::arena_bytes`. */
+        uint64_t bytes_arena = 0;
+        /** BuDDy's node table, see `hoax::bdd_bytes`. */
+        uint64_t bytes_bdd = 0;
+
+        /* The estimated expansion size, see `hoax::estimate_expansion`. */
+        uint64_t estimated_states = 0;
+        uint64_t estimated_edges = 0;
+        uint64_t estimated_bytes = 0;
+        /** The name of the engine that solved the game, see `hoax::Engine`. */
+        std::string engine = "explicit";
+        /** The declared properties of the game, see `hoax::GameProperties::names`. */
+        std::string properties;
+
+        /* Expansion counters. */
+        /** The number of "even player" states created by the expansion. */
+        uint64_t eve_states = 0;
+        /** The number of uncontrollable evaluations that left no move. */
+        uint64_t evals_skipped = 0;
+        /** The number of forced "even player" states contracted away in the arena. */
+        uint64_t eve_contracted = 0;
+        /** The number of edge vertices added for "even player" states with mixed priorities. */
+        uint64_t edge_vertices = 0;
+        /** The number of states whose expansion was reused from a previous game. */
+        uint64_t states_reused = 0;
+
+        /* Solver counters. */
+        /** The number of vertices of the bisimulation quotient, if solved. */
+        uint64_t quotient_states = 0;
+        uint64_t zielonka_calls = 0;
+        /** The current recursion depth of zielonka. */
+        unsigned int zielonka_depth = 0;
+        unsigned int zielonka_depth_max = 0;
+        uint64_t attractor_calls = 0;
+        uint64_t attractor_rounds = 0;
+        /** The number of successor vertices visited by the attractors. */
+        uint64_t edges_scanned = 0;
+        /** The number of adjacency rows visited by the dense attractors. */
+        uint64_t rows_scanned = 0;
+        /** True iff. a seeded solution was valid, so zielonka did not run. */
+        bool warm_start = false;
+        /** The result of checking the solution: "valid", "invalid" or "unchecked". */
+        std::string certificate = "unchecked";
+
+        /** Serialize the stats as a single line JSON object.
+
+            @param[in] path_in The path to the input file of the parity game
+            @param[in] result The result of the game, e.g. "REAL" or "SKIP"
+            @param[in] num_states The number of states of the solved arena
+            @param[in] num_edges The number of edges of the solved arena
+            @return The JSON object, without a trailing newline
+        */
+        std::string to_json(const std::string &path_in, const std::string &result,
+                            const unsigned int num_states, const unsigned int num_edges) const;
+    };
+
+    /** The wall clock seconds elapsed since the given time point. */
+    inline double seconds_since(const budget_clock::time_point start) {
+        return std::chrono::duration<double>(budget_clock::now() - start).count();
+    }
+
+    /** Add the wall time of a scope to a `hoax::Stats` time field. */
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(double &field) : field(field), start(budget_clock::now()) {}
+        ~PhaseTimer() { this->field += seconds_since(this->start); }
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer &operator=(const PhaseTimer&) = delete;
+
+    private:
+        double &field;
+        const budget_clock::time_point start;
+    };
+
+    /** Escape a string for use as a JSON string literal, including quotes. */
+    std::string json_string(const std::string &s);
+}
+
+#endif
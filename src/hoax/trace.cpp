@@ -0,0 +1,33 @@
+#include "trace.h"
+#include "stats.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+void hoax::Tracer::write(std::ostream &out, const std::string &name) const {
+    /* The format takes timestamps in microseconds; keep nanoseconds as decimals. */
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"game\": " << hoax::json_string(name)
+        << ", \"dropped\": " << this->dropped << "}, \"traceEvents\": [\n";
+    out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": "
+        << hoax::json_string(name) << "}}";
+    for (const hoax::TraceEvent &event : this->recorded) {
+        out << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"solver\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+            << ", \"ts\": " << event.start / 1000.0
+            << ", \"dur\": " << event.duration / 1000.0
+            << ", \"args\": {";
+        for (unsigned int i = 0; i < event.num_args; i++)
+            out << (i ? ", " : "") << "\"" << event.arg_names[i] << "\": " << event.arg_values[i];
+        out << "}}";
+    }
+    out << "\n]}\n";
+}
+
+void hoax::Tracer::write(const std::filesystem::path &path, const std::string &name) const {
+    std::ofstream out(path);
+    if (!out.is_open())
+        throw std::runtime_error("Could not open ofstream to write trace " + path.string());
+    this->write(out, name);
+    if (!out)
+        throw std::runtime_error("Could not write trace " + path.string());
+}
@@ -0,0 +1,132 @@
+#ifndef HOAX_TRACE_H
+#define HOAX_TRACE_H
+
+#include "cancel.h"
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace hoax {
+
+    /** The maximum number of events a tracer keeps; later events are dropped. */
+    #define TRACE_MAX_EVENTS (1 << 20)
+    /** The maximum number of arguments of a trace event. */
+    #define TRACE_MAX_ARGS 6
+
+    /** A timed span of the solver, e.g. a zielonka frame or an attractor call. */
+    struct TraceEvent {
+        /** The name of the span, a string literal. */
+        const char *name = nullptr;
+        /** The start of the span, in nanoseconds since the tracer was created. */
+        int64_t start = 0;
+        /** The duration of the span, in nanoseconds. */
+        int64_t duration = 0;
+        /* The named integer arguments of the span, e.g. its recursion depth.
+            They are left uninitialized, since a disabled scope never sets them. */
+        const char *arg_names[TRACE_MAX_ARGS];
+        int64_t arg_values[TRACE_MAX_ARGS];
+        unsigned int num_args = 0;
+    };
+
+    /** Records the spans of the solver of a game, and writes them in the
+        Chrome trace event format, which both chrome://tracing and Perfetto
+        (https://ui.perfetto.dev) open.
+
+        The spans nest by time, so the viewers draw the zielonka recursion
+        as a flame graph: every frame sits below its caller, with its
+        attractors and its two recursive calls. The solver only traces if
+        `hoax::SolverOptions::tracer` is set; otherwise no clock is read and
+        nothing is recorded.
+    */
+    class Tracer {
+    public:
+        /** @param[in] max_events The maximum number of events to keep */
+        explicit Tracer(const size_t max_events = TRACE_MAX_EVENTS)
+            : origin(budget_clock::now()), max_events(max_events) {}
+
+        /** The nanoseconds elapsed since the tracer was created. */
+        int64_t now() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(budget_clock::now() - this->origin).count();
+        }
+
+        /** Keep an event, or count it as dropped if the tracer is full. */
+        void record(const TraceEvent &event) {
+            if (this->recorded.size() < this->max_events)
+                this->recorded.push_back(event);
+            else
+                this->dropped++;
+        }
+
+        /** The events kept so far, in the order in which they ended. */
+        const std::vector<TraceEvent> &events() const { return this->recorded; }
+
+        /** The number of events dropped because the tracer was full. */
+        uint64_t num_dropped() const { return this->dropped; }
+
+        /** Write the events as a Chrome trace JSON object.
+
+            @param[out] out The stream to write to
+            @param[in] name The name of the traced game, e.g. its input file
+        */
+        void write(std::ostream &out, const std::string &name) const;
+
+        /** Write the events as a Chrome trace JSON file.
+
+            @param[in] path The path of the file to write
+            @param[in] name The name of the traced game, e.g. its input file
+            @throw std::runtime_error If the file could not be written
+        */
+        void write(const std::filesystem::path &path, const std::string &name) const;
+
+    private:
+        const budget_clock::time_point origin;
+        const size_t max_events;
+        std::vector<TraceEvent> recorded;
+        uint64_t dropped = 0;
+    };
+
+    /** Record the span of a scope as an event of a tracer, like
+        `hoax::PhaseTimer` adds the wall time of a scope. A null tracer
+        disables the scope, so it neither reads the clock nor records.
+    */
+    class TraceScope {
+    public:
+        /** @param[in] tracer The tracer to record to, or null
+            @param[in] name The name of the span, a string literal */
+        TraceScope(hoax::Tracer *tracer, const char *name) : tracer(tracer) {
+            if (this->tracer != nullptr) {
+                this->event.name = name;
+                this->event.start = this->tracer->now();
+            }
+        }
+
+        ~TraceScope() {
+            if (this->tracer != nullptr) {
+                this->event.duration = this->tracer->now() - this->event.start;
+                this->tracer->record(this->event);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope &operator=(const TraceScope&) = delete;
+
+        /** True iff. the scope records, i.e. its arguments are worth computing. */
+        bool enabled() const { return this->tracer != nullptr; }
+
+        /** Add a named argument to the span; the name must be a string literal. */
+        void arg(const char *key, const int64_t value) {
+            if (this->tracer == nullptr || this->event.num_args == TRACE_MAX_ARGS)
+                return;
+            this->event.arg_names[this->event.num_args] = key;
+            this->event.arg_values[this->event.num_args++] = value;
+        }
+
+    private:
+        hoax::Tracer *const tracer;
+        hoax::TraceEvent event;
+    };
+}
+
+#endif
@@ -1,8 +1,21 @@
 #include "hoax.h"
+#include "aiger.h"
 #include "utils.h"
+#include "batch.h"
+#include "estimate.h"
+#include "queue.h"
+#include "daemon.h"
+#include "export.h"
+#include "certificate.h"
 #include <filesystem>
 #include <iostream>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <optional>
 #include <getopt.h>
+#include <csignal>
+#include <unistd.h>
 #include <spot/parseaut/public.hh>
 
 /** Flag set by "-v" */
@@ -17,22 +30,869 @@ static int flag_dump = 0;
 /** Flag set by "-s" */
 static int flag_strict = 0;
 
+/** Flag set by "-w" */
+static int flag_cache_write = 0;
+
+/** Flag set by "-c" */
+static int flag_cache_read = 0;
+
+/** Value set by "-j", the number of worker processes. */
+static unsigned int flag_jobs = 1;
+
+/** Flag set by "-p" */
+static int flag_pipeline = 0;
+
+/** Flag set by "-a" */
+static int flag_aiger = 0;
+
+/** Flag set by "-S" */
+static int flag_stats = 0;
+
+/** Flag set by "-i" */
+static int flag_incremental = 0;
+
+/** Flag set by "-q" */
+static int flag_quotient = 0;
+
+/** Value set by "-o", the vertex order to renumber every arena in. */
+static hoax::VertexOrder flag_order = hoax::ORDER_NONE;
+
+/** Value set by "-r", the vertex sets of the solver kernel. */
+static hoax::SetPolicy flag_sets = hoax::SETS_AUTO;
+
+/** Value set by "-g", the recursive algorithm of the solver. */
+static hoax::Algorithm flag_algorithm = hoax::ALGORITHM_ZIELONKA;
+
+/** Value set by "-x", what to export of every solved arena, if anything. */
+static std::optional<hoax::ExportOptions> flag_export;
+
+/** Flag set by "-C", or implied by "-v". */
+static int flag_certify = 0;
+
+/** Flag set by "-Z". */
+static int flag_trace = 0;
+
+/** Value set by "-e", the engine to solve every parity game with. */
+static hoax::Engine flag_engine = hoax::ENGINE_AUTO;
+
+/** Value set by "-m", the memory budget per parity game, in MiB; 0 for unlimited. */
+static double flag_memory_budget = 0;
+
+/** Flag set by "-D", or implied by "-U". */
+static int flag_daemon = 0;
+
+/** Value set by "-U", the Unix domain socket path of the daemon. */
+static std::filesystem::path flag_socket;
+
+/** Flag set by "-W" */
+static int flag_winners = 0;
+
+/** Value set by "-t", the runtime budget per parity game, in seconds. */
+static double flag_budget_game = 0;
+
+/** Value set by "-T", the runtime budget of all parity games, in seconds. */
+static double flag_budget_batch = 0;
+
 /** The default output directory. */
 const std::filesystem::path DEFAULT_DIR_OUT("output/");
 
 /** The default input directory. */
 const std::filesystem::path DEFAULT_DIR_IN("input/");
 
-/** The maximum runtime allowed for solving a parity game, in seconds.
+/** The default directory of the expanded arena cache. */
+const std::filesystem::path DEFAULT_DIR_CACHE("output/cache/");
+
+/** The default maximum runtime allowed for solving a parity game, in seconds.
     Quit early if this deadline is exceeded. */
 const unsigned int RUNTIME_MAX_SEC = 480;
 
+/** The absolute deadline of the entire batch of parity games, see "-T". */
+static hoax::budget_clock::time_point batch_deadline = hoax::budget_clock::time_point::max();
+
+/** The capacity of the queues between the pipeline stages. This bounds the
+    number of games that are read or expanded ahead of the solver. */
+const size_t PIPELINE_QUEUE_SIZE = 2;
+
+
+/** The bdd_dict shared by all games in incremental mode, see "-i". BDDs of
+    different games can only be compared if they share their bdd_dict. */
+static spot::bdd_dict_ptr incremental_dict;
+
+/** The previously solved game in incremental mode, see "-i". */
+static std::shared_ptr<hoax::HOAxParityTwA> incremental_previous;
+
+
+/** Get the watchdog that cancels games once their runtime budget runs out.
+
+    The watchdog is created on first use. A forked batch worker does not
+    inherit the watchdog thread of its parent, so the parent never uses it.
+*/
+static hoax::Watchdog &watchdog() {
+  static hoax::Watchdog instance;
+  static bool initialized = false;
+  if (!initialized) {
+    instance.set_batch_deadline(batch_deadline);
+    initialized = true;
+  }
+  return instance;
+}
+
+/** Start the runtime budget of a single parity game.
+
+    @param[in] spent The seconds of the budget that were already spent
+*/
+static std::shared_ptr<hoax::CancelToken> arm_game_token(const double spent = 0) {
+  return watchdog().arm(std::chrono::duration_cast<hoax::budget_clock::duration>(
+    std::chrono::duration<double>(flag_budget_game)),
+    std::chrono::duration_cast<hoax::budget_clock::duration>(std::chrono::duration<double>(spent)));
+}
+
+/** Check the parse result of an eHOA game, and enforce the automaton types
+    and properties we expect in the benchmarks.
+
+    @param[in] pa The parse result of the game
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[out] out The stream to write the reason to, iff. the game is skipped
+    @param[out] reason The reason the game is skipped, e.g. "ABORT", or empty
+    @return The parsed automaton, or nullptr iff. the game is skipped
+*/
+static spot::twa_graph_ptr check_game(const spot::parsed_aut_ptr &pa,
+                                      const std::filesystem::path &path_in,
+                                      std::ostream &out, std::string &reason) {
+  /* Report why the game is skipped, as a "SKIP" or "WARN" line. */
+  auto skip = [&](const char *level, const std::string &why) -> spot::twa_graph_ptr {
+    reason = why;
+    out << level << "\t" << why << "\t" << path_in.string() << std::endl;
+    return nullptr;
+  };
+  reason.clear();
+
+  if (flag_verbose && pa->format_errors(out)) {
+    return skip("SKIP", "FORMAT ERR");
+  }
+  if (pa->aborted) {
+    return skip("SKIP", "ABORT");
+  }
+
+  spot::twa_graph_ptr aut = pa->aut;
+  if (aut == nullptr) {
+    return skip("SKIP", "TwA MISSING");
+  }
+
+  std::string prop_name;
+  // The "state-player" prop is NOT specified in the benchmarks!
+  // Since it's a spot extension to HOA, our inputs should not have it!
+  prop_name = PROP_SPOT_STATE_PLAYER;
+  auto state_player = aut->get_named_prop<std::vector<bool>>(prop_name);
+  if (flag_strict && state_player != nullptr) {
+    return skip("SKIP", "PROP UNEXPECTED " + prop_name);
+  }
+
+  // The "state-winner" prop is probably only set by spot after solving
+  // the parity game with its builtin algo?
+  // Since it's a spot extension to HOA, our inputs should not have it!
+  prop_name = PROP_SPOT_STATE_WINNER;
+  auto state_winner = aut->get_named_prop<std::vector<bool>>(prop_name);
+  if (flag_strict && state_winner != nullptr) {
+    return skip("SKIP", "PROP UNEXPECTED " + prop_name);
+  }
+
+  // The "strategy" prop is probably only set by spot after solving
+  // the parity game with its builtin algo?
+  // Since it's a spot extension to HOA, our inputs should not have it!
+  prop_name = PROP_SPOT_STRAT;
+  auto strategy = aut->get_named_prop<std::vector<unsigned>>(prop_name);
+  if (flag_strict && strategy != nullptr) {
+    return skip("SKIP", "PROP UNEXPECTED " + prop_name);
+  }
+
+  /* The "synthesis-outputs" prop is set by the "controllable-AP" eHOA header.
+    The type of this named prop is `bdd`, NOT `spot::bdd_dict`!
+    That typing mistake cost me hours of debugging ... curse you, inheritance!
+
+    For an example of using the "synthesis-outputs" bdd, see spot source code:
+        https://gitlab.lre.epita.fr/spot/spot/-/blob/next/bin/ltlsynt.cc#L903
+
+    The "synthesis-outputs" bdd is a confunction of all controllable APs.
+    i.e.
+
+        AP: 4 "a" "b" "c" "d"
+        controllable-AP: 0 2
+
+    results in a "synthesis-outputs" bdd that represents the propositional
+    formula (a & c).
+   */
+  prop_name = PROP_SPOT_SYNTH_OUTPUT;
+  auto synth_out = aut->get_named_prop<bdd>(prop_name);
+  if (synth_out == nullptr) {
+    return skip("SKIP", "PROP MISSING " + prop_name);
+  }
+
+  /* Enforce the automaton types and properties we expect in the benchmarks.
+   */
+  bool pmax, podd;
+  bool isparity = aut->acc().is_parity(pmax, podd);
+  if (flag_strict && !(isparity || aut->acc().is_f() || aut->acc().is_t())) {
+    return skip("WARN", "NON-PARITY TwA? '" + aut->acc().name() + "'");
+  }
+
+  /* The expansion and the priorities trust the declared properties, see
+    `hoax::GameProperties`, so validate them against the edges. */
+  if (flag_strict) {
+    const std::string violated = hoax::check_properties(aut, hoax::declared_properties(aut));
+    if (!violated.empty()) {
+      return skip("SKIP", "PROP INVALID " + violated);
+    }
+  }
+
+  return aut;
+}
+
+/** Check the parse result of an eHOA game, see above, without the reason. */
+static spot::twa_graph_ptr check_game(const spot::parsed_aut_ptr &pa,
+                                      const std::filesystem::path &path_in,
+                                      std::ostream &out) {
+  std::string reason;
+  return check_game(pa, path_in, out, reason);
+}
+
+/** Estimate the expansion size of a game, and choose the engine to solve it with.
+
+    The estimate is printed in verbose mode, and whenever the game is not
+    expanded explicitly.
+
+    @param[in] aut The parity game
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[in,out] stats The stats of the game, which get the estimate and the engine
+    @param[out] out The stream to write the estimate to
+    @return The engine to solve the game with
+*/
+static hoax::Engine choose_engine(const spot::twa_graph_ptr aut, const std::filesystem::path &path_in,
+                                  hoax::Stats &stats, std::ostream &out) {
+  hoax::ExpansionEstimate estimate;
+  {
+    hoax::PhaseTimer timer(stats.time_expand);
+    hoax::PerfScope perf(stats.perf_expand);
+    hoax::MemoryScope memory(stats.memory_expand);
+    estimate = hoax::estimate_expansion(aut);
+  }
+  stats.estimated_states = estimate.states;
+  stats.estimated_edges = estimate.edges;
+  stats.estimated_bytes = estimate.bytes;
+
+  const hoax::Engine engine = flag_engine != hoax::ENGINE_AUTO ? flag_engine :
+    hoax::choose_engine(estimate, uint64_t(flag_memory_budget * 1024 * 1024));
+  stats.engine = hoax::engine_name(engine);
+
+  if (flag_verbose || engine != hoax::ENGINE_EXPLICIT)
+    out << "ESTIMATE	states=" << estimate.states << " edges=" << estimate.edges
+        << " MiB=" << estimate.bytes / (1024 * 1024) << " k_max=" << estimate.max_uncontrollable
+        << "	" << stats.engine << "	" << path_in.string() << std::endl;
+  return engine;
+}
+
+/** Add the stats of the phases before the expansion, i.e. parsing and
+    estimating, to the stats of the expanded game. */
+static void add_stats_before_expansion(const hoax::Stats &before, hoax::Stats &stats) {
+  stats.time_parse += before.time_parse;
+  stats.time_expand += before.time_expand;
+  stats.perf_parse.add(before.perf_parse);
+  stats.perf_expand.add(before.perf_expand);
+  stats.memory_parse.add(before.memory_parse);
+  stats.memory_expand.add(before.memory_expand);
+  stats.estimated_states = before.estimated_states;
+  stats.estimated_edges = before.estimated_edges;
+  stats.estimated_bytes = before.estimated_bytes;
+  stats.engine = before.engine;
+}
+
+/** Solve a game with spot's solver instead of expanding it, and print the result.
+
+    Spot's solver does not check the runtime budget, so only the phases
+    before it can be cancelled.
+
+    @param[in] aut The parity game
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[in] token The runtime budget of the game
+    @param[in] stats The stats of the phases before solving, e.g. parsing
+    @param[out] out The stream to write the result to
+*/
+static void solve_spot_game(const spot::twa_graph_ptr aut, const std::filesystem::path &path_in,
+                            const std::shared_ptr<const hoax::CancelToken> &token,
+                            hoax::Stats stats, std::ostream &out) {
+  std::string result = "SKIP";
+  try {
+    {
+      hoax::PhaseTimer timer(stats.time_solve);
+      result = hoax::solve_spot(aut) ? "REAL" : "UNREAL";
+    }
+    out << result.c_str() << "	"
+        << (std::to_string(token->elapsed()) + "s").c_str() << "	"
+        << path_in.c_str() << (flag_verbose ? "	(spot)" : "") << std::endl;
+  } catch (std::runtime_error &e) {
+    out << "SKIP	" << e.what() << "	" << path_in.string() << std::endl;
+  }
+  if (flag_stats)
+    out << stats.to_json(path_in.string(), result, 0, 0) << std::endl;
+}
+
+/** Check the solution of a game by its certificate, see `hoax::check_solution`.
+
+    @param[in] hptwa The solved parity game, whose stats record the check
+    @return The first violation found, or the empty string iff. the solution is valid
+*/
+static std::string certify_game(const hoax::HOAxParityTwA &hptwa) {
+  std::string reason;
+  {
+    hoax::PhaseTimer timer(hptwa.stats.time_check);
+    reason = hoax::check_solution(hptwa.arena, hptwa.winners, hptwa.strategy);
+  }
+  hptwa.stats.certificate = reason.empty() ? "valid" : "invalid";
+  return reason;
+}
+
+/** Export the solved arena of a game as set by "-x", see `hoax::export_arena`.
+
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[in] hptwa The solved parity game
+    @param[out] out The stream to report the written files to
+*/
+static void export_game(const std::filesystem::path &path_in, const hoax::HOAxParityTwA &hptwa,
+                        std::ostream &out) {
+  std::vector<std::filesystem::path> paths;
+  {
+    hoax::PhaseTimer timer(hptwa.stats.time_export);
+    paths = hoax::export_arena(path_in, DEFAULT_DIR_OUT, *flag_export, hptwa.arena, hptwa.winners);
+  }
+  for (const std::filesystem::path &path : paths)
+    out << "Exported arena to: " << path.c_str() << std::endl;
+}
+
+/** Write the solver trace of a game as set by "-Z", see `hoax::Tracer`.
+
+    The trace is also written if solving the game failed, e.g. ran out of
+    time, since those are the games whose recursion is worth a look.
+
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[in] tracer The tracer of the game
+    @param[out] out The stream to report the written file to
+*/
+static void trace_game(const std::filesystem::path &path_in, const hoax::Tracer &tracer, std::ostream &out) {
+  const std::filesystem::path path_trace = DEFAULT_DIR_OUT.string() + path_in.filename().string() + ".trace.json";
+  try {
+    tracer.write(path_trace, path_in.string());
+    out << "Traced solver to: " << path_trace.c_str() << std::endl;
+  } catch (std::runtime_error &e) {
+    out << "SKIP\t" << e.what() << "\t" << path_in.string() << std::endl;
+  }
+}
+
+/** Solve an already expanded arena, and print the result.
+
+    No TwA is available for the arena, so neither the spot baseline nor the
+    dot dump can be computed.
+
+    @param[in] arena The expanded parity arena
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[in] token If this token is cancelled, then quit early
+    @param[in] cached If true, then the arena was loaded from the arena cache
+    @param[in] stats The stats of the phases before solving, e.g. parsing
+    @param[out] out The stream to write the result to
+*/
+static void solve_arena(const hoax::Arena &arena, const std::filesystem::path &path_in,
+                        const std::shared_ptr<const hoax::CancelToken> &token, const bool cached,
+                        const hoax::Stats &stats, std::ostream &out) {
+  hoax::HOAxParityTwA hptwa = hoax::HOAxParityTwA(arena, token);
+  hptwa.stats = stats;
+  hptwa.options.quotient = flag_quotient;
+  hptwa.options.order = flag_order;
+  hptwa.options.sets = flag_sets;
+  hptwa.options.algorithm = flag_algorithm;
+  if (flag_trace)
+    hptwa.options.tracer = std::make_shared<hoax::Tracer>();
+  std::string result = "SKIP";
+  try {
+    /* The game is realizable iff. Eve wins from the initial state. */
+    const bool SOL_COMPUTED = !hptwa.solve_parity_game();
+    result = SOL_COMPUTED ? "REAL" : "UNREAL";
+
+    out << result.c_str() << "\t"
+        << (std::to_string(hptwa.token->elapsed()) + "s").c_str() << "\t"
+        << path_in.c_str() << (flag_verbose && cached ? "\t(cached)" : "") << std::endl;
+
+    if (flag_certify) {
+      const std::string invalid = certify_game(hptwa);
+      if (!invalid.empty())
+        out << "INVALID\t" << invalid << "\t" << path_in.string() << std::endl;
+    }
+
+    if (flag_export)
+      export_game(path_in, hptwa, out);
+  } catch (std::runtime_error &e) {
+    out << "SKIP\t" << e.what() << "\t" << path_in.string() << std::endl;
+  }
+  if (flag_trace)
+    trace_game(path_in, *hptwa.options.tracer, out);
+  if (flag_stats)
+    out << hptwa.stats.to_json(path_in.string(), result, arena.num_states, arena.num_edges) << std::endl;
+}
+
+/** Solve the parity games of the input files in a three stage pipeline.
+
+    1) A reader thread reads (and hashes) the input files.
+    2) The calling thread parses and expands the games.
+    3) A solver thread solves the expanded arenas and prints the results.
+
+    Spot's BDD state is global and not thread safe. So all BDD work, i.e.
+    parsing and expansion, stays in stage 2, and only the BDD free arena is
+    handed to stage 3. The stages are connected by bounded queues, so the
+    number of games in flight, and thus memory use, stays bounded.
+
+    Each stage handles the games in input order, so the output order is the
+    same as that of `solve_file`.
+
+    @param[in] paths_in The paths to the eHOA input files of the parity games
+*/
+static void solve_pipeline(const std::vector<std::filesystem::path> &paths_in) {
+  /** An input file read into memory. */
+  struct ReadGame {
+    std::filesystem::path path_in;
+    std::string data;
+    uint64_t source_hash = 0;
+    bool exists = true;
+  };
+
+  /** An expanded game, or the reason it is skipped. */
+  struct ExpandedGame {
+    std::filesystem::path path_in;
+    std::optional<hoax::Arena> arena;
+    hoax::Stats stats;
+    bool cached = false;
+    uint64_t source_hash = 0;
+    std::shared_ptr<hoax::CancelToken> token;
+    /** The seconds of the budget spent before the game was queued. */
+    double spent = 0;
+    hoax::budget_clock::time_point queued;
+    std::string log;
+  };
+
+  hoax::BoundedQueue<ReadGame> queue_read(PIPELINE_QUEUE_SIZE);
+  hoax::BoundedQueue<ExpandedGame> queue_expanded(PIPELINE_QUEUE_SIZE);
+
+  /* Stage 1: I/O. */
+  std::thread reader([&paths_in, &queue_read]() {
+    for (const auto &path_in : paths_in) {
+      ReadGame game;
+      game.path_in = path_in;
+      std::ifstream in(path_in, std::ios::binary);
+      game.exists = in.is_open();
+      if (game.exists) {
+        std::ostringstream data;
+        data << in.rdbuf();
+        game.data = data.str();
+        game.source_hash = hoax::data_hash(game.data.data(), game.data.size());
+      }
+      queue_read.push(std::move(game));
+    }
+    queue_read.close();
+  });
+
+  /* Stage 3: solving, which only touches the BDD free arena. */
+  std::thread solver([&queue_expanded]() {
+    while (std::optional<ExpandedGame> game = queue_expanded.pop()) {
+      std::cout << game->log;
+      if (!game->arena)
+        continue;
+
+      /* The budget pauses while the game waits in the queue, so a game
+        gets as much time to solve as it would get in sequential mode. */
+      game->stats.time_queue = std::chrono::duration<double>(hoax::budget_clock::now() - game->queued).count();
+      game->token = arm_game_token(game->spent);
+
+      std::ostringstream out;
+      solve_arena(*game->arena, game->path_in, game->token, game->cached, game->stats, out);
+      if (flag_cache_write && !game->cached) {
+        try {
+          hoax::write_arena(hoax::arena_cache_path(DEFAULT_DIR_CACHE, game->path_in),
+                            *game->arena, game->source_hash);
+        } catch (std::runtime_error &e) {
+          out << "WARN\t" << e.what() << "\t" << game->path_in.string() << std::endl;
+        }
+      }
+      std::cout << out.str() << std::flush;
+    }
+  });
+
+  /* Stage 2: parsing and expansion, which own all BDD state. */
+  while (std::optional<ReadGame> read = queue_read.pop()) {
+    ExpandedGame game;
+    game.path_in = read->path_in;
+    game.source_hash = read->source_hash;
+    /* Each game has an individual runtime budget. */
+    game.token = arm_game_token();
+
+    std::ostringstream log;
+    if (!read->exists) {
+      log << "SKIP\tPATH DOES NOT EXIST\t" << read->path_in.string() << std::endl;
+    } else if (flag_cache_read &&
+               (game.arena = hoax::map_arena(hoax::arena_cache_path(DEFAULT_DIR_CACHE, read->path_in),
+                                             read->source_hash))) {
+      game.cached = true;
+    } else {
+      spot::parsed_aut_ptr pa;
+      {
+        hoax::PhaseTimer timer(game.stats.time_parse);
+        hoax::PerfScope perf(game.stats.perf_parse);
+        hoax::MemoryScope memory(game.stats.memory_parse);
+        spot::automaton_stream_parser parser(read->data.c_str(), read->path_in.string());
+        pa = parser.parse(spot::make_bdd_dict());
+      }
+      /* Release the file content as soon as possible. */
+      read->data = std::string();
+
+      spot::twa_graph_ptr aut = check_game(pa, read->path_in, log);
+      /* Spot's solver needs the BDDs, so it runs on this thread. */
+      if (aut != nullptr && choose_engine(aut, read->path_in, game.stats, log) == hoax::ENGINE_SPOT) {
+        solve_spot_game(aut, read->path_in, game.token, game.stats, log);
+      } else if (aut != nullptr) {
+        try {
+          /* Keep only the arena; the TwAs hold BDDs, so they must be
+            destroyed on this thread. */
+          hoax::HOAxParityTwA hptwa(aut, game.token);
+          add_stats_before_expansion(game.stats, hptwa.stats);
+          game.arena = hptwa.arena;
+          game.stats = hptwa.stats;
+        } catch (std::runtime_error &e) {
+          log << "SKIP\t" << e.what() << "\t" << read->path_in.string() << std::endl;
+        }
+      }
+    }
+    game.log = log.str();
+    game.spent = game.token->elapsed();
+    game.queued = hoax::budget_clock::now();
+    queue_expanded.push(std::move(game));
+  }
+  queue_expanded.close();
+
+  reader.join();
+  solver.join();
+}
+
+/** Solve the parity game of a single input file, and print the result.
+
+    @param[in] path_in The path to the eHOA input file of the parity game
+*/
+static void solve_file(const std::filesystem::path &path_in) {
+  /* Each game has an individual runtime budget. */
+  const std::shared_ptr<hoax::CancelToken> token = arm_game_token();
+
+  /* Ensure the input path exists. */
+  if (!std::filesystem::exists(path_in)) {
+    printf("SKIP\tPATH DOES NOT EXIST\t%s\n", path_in.c_str());
+    return;
+  }
+
+  /* A cached arena has no automata, which the controller, the baseline,
+    the dumps and the verbose report are computed from. So these flags
+    expand the game again instead of loading it from the cache. */
+  const bool cache_read = flag_cache_read && !(flag_aiger || flag_baseline || flag_dump || flag_verbose);
+
+  /* A cached arena is only valid for the exact input file content
+    it was expanded from, so key the cache on the content hash. */
+  uint64_t source_hash = 0;
+  std::filesystem::path path_cache;
+  if (cache_read || flag_cache_write) {
+    source_hash = hoax::file_hash(path_in);
+    path_cache = hoax::arena_cache_path(DEFAULT_DIR_CACHE, path_in);
+  }
+
+  if (cache_read) {
+    std::optional<hoax::Arena> cached = hoax::map_arena(path_cache, source_hash);
+    if (cached) {
+      solve_arena(*cached, path_in, token, true, hoax::Stats(), std::cout);
+      return;
+    }
+  }
+
+  // Parse a HOA file. See
+  // https://spot.lre.epita.fr/doxygen/group__twa__io.html#ga7ddd70d2b02e1234814a2f7fa6afe052
+  hoax::Stats stats_parse;
+  spot::parsed_aut_ptr pa;
+  {
+    hoax::PhaseTimer timer(stats_parse.time_parse);
+    hoax::PerfScope perf(stats_parse.perf_parse);
+    hoax::MemoryScope memory(stats_parse.memory_parse);
+    if (flag_incremental && incremental_dict == nullptr)
+      incremental_dict = spot::make_bdd_dict();
+    pa = spot::parse_aut(path_in, flag_incremental ? incremental_dict : spot::make_bdd_dict());
+  }
+  spot::twa_graph_ptr aut = check_game(pa, path_in, std::cout);
+  if (aut == nullptr)
+    return;
+
+  if (choose_engine(aut, path_in, stats_parse, std::cout) == hoax::ENGINE_SPOT) {
+    /* A game that is not expanded cannot be reused by the next one. */
+    incremental_previous = nullptr;
+    solve_spot_game(aut, path_in, token, stats_parse, std::cout);
+    return;
+  }
+
+  bool pmax, podd;
+  aut->acc().is_parity(pmax, podd);
+
+  /* The tracer outlives the game, so a game that fails is traced too. */
+  const std::shared_ptr<hoax::Tracer> tracer = flag_trace ? std::make_shared<hoax::Tracer>() : nullptr;
+  try {
+    /* FIRST solve using my own implementation, so that I cannot mistake
+        spot's solution for my own. */
+    /* In incremental mode, reuse the expansion and solution of the previous game. */
+    std::shared_ptr<hoax::HOAxParityTwA> hptwa_ptr = incremental_previous != nullptr ?
+      std::make_shared<hoax::HOAxParityTwA>(aut, *incremental_previous, token) :
+      std::make_shared<hoax::HOAxParityTwA>(aut, token);
+    /* Release the previous game before solving, it is not needed anymore. */
+    incremental_previous = nullptr;
+    hoax::HOAxParityTwA &hptwa = *hptwa_ptr;
+    add_stats_before_expansion(stats_parse, hptwa.stats);
+    hptwa.options.quotient = flag_quotient;
+    hptwa.options.order = flag_order;
+    hptwa.options.sets = flag_sets;
+    hptwa.options.algorithm = flag_algorithm;
+    hptwa.options.tracer = tracer;
+
+    // Call my own implementation of a parity game solver.
+    // The priorities are normalized for the acceptance condition, so
+    // the game is realizable iff. Eve wins from the initial state.
+    const bool SOL_COMPUTED = !hptwa.solve_parity_game();
+    const std::string SOL_STR_COMPUTED = SOL_COMPUTED ? "REAL" : "UNREAL";
+
+    if (flag_cache_write)
+      hoax::write_arena(path_cache, hptwa.arena, source_hash);
+
+    if (flag_dump) {
+      hptwa.set_state_names();
+
+      std::filesystem::path ext_path(DEFAULT_DIR_OUT);
+      ext_path.append("EXT_");
+
+      hoax::to_dot(path_in, DEFAULT_DIR_OUT, hptwa.src);
+      hoax::to_dot(path_in, ext_path, hptwa.exp);
+    }
+
+    if (flag_export)
+      export_game(path_in, hptwa, std::cout);
+
+    /* Only a realizable game has a controller. */
+    if (flag_aiger && SOL_COMPUTED) {
+      const hoax::AIG aig = hoax::synthesize_controller(hptwa);
+      const std::string path_aag = DEFAULT_DIR_OUT.string() + path_in.filename().string() + ".aag";
+      std::ofstream aag_of(path_aag);
+      if (!aag_of.is_open())
+        throw std::runtime_error("Could not open ofstream to write AIGER " + path_aag);
+      aig.write_aag(aag_of, "HOAx controller for " + path_in.filename().string());
+      if (flag_verbose)
+        std::cout << "AIGER\tL=" << aig.num_latches() << " A=" << aig.num_ands() << "\t"
+                  << path_aag << std::endl;
+    }
+
+    /* Check the solution by its certificate, in close to linear time. */
+    std::string invalid;
+    if (flag_certify) {
+      invalid = certify_game(hptwa);
+      if (!invalid.empty())
+        std::cout << "INVALID\t" << invalid << "\t" << path_in.string() << std::endl;
+    }
+
+    /* Print only my own realizability result & input file path. */
+    if (!flag_verbose)
+      std::cout << SOL_STR_COMPUTED.c_str() << "\t"
+                << (std::to_string(hptwa.token->elapsed()) + "s").c_str() << "\t"
+                << path_in.c_str() << std::endl;
+    /* Else, also print whether the certificate is valid, or spot's result as a baseline. */
+    else {
+      std::string SOL_STR_CHECK = invalid.empty() ? "VALID" : "INVALID";
+
+      if (flag_baseline) {
+        /* Compare against spot's own synthesis as a baseline. In `exp`,
+          the "state-player" states belong to the environment, while spot's
+          player 1 wins iff. the acceptance holds. So `spot::solve_parity_game()`
+          on `exp` solves the game in which the environment wants acceptance.
+          `hoax::solve_spot` splits the source automaton with the controller
+          as player 1 instead, so it decides realizability like hoax does. */
+        const bool SOL_ACTUAL = hoax::solve_spot(aut);
+        SOL_STR_CHECK = SOL_ACTUAL ? "REAL" : "UNREAL";
+
+        /* For the winners of every state, solve a copy of `exp` with spot,
+          in which Eve owns the "state-player" states. Spot's winner is then
+          true iff. Eve wins, while hoax's winner is true iff. Adam wins. */
+        spot::twa_graph_ptr exp_eve = spot::make_twa_graph(hptwa.exp, spot::twa::prop_set::all());
+        std::vector<bool> players_eve = spot::get_state_players(hptwa.exp);
+        players_eve.flip();
+        spot::set_state_players(exp_eve, players_eve);
+        spot::solve_parity_game(exp_eve);
+        auto state_winners_spot = exp_eve->get_named_prop<std::vector<bool>>(PROP_SPOT_STATE_WINNER);
+        auto state_winners_hoax = hptwa.exp->get_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER);
+        unsigned int nr_diffs = 0;
+        for (unsigned int i = 0; i < state_winners_hoax->size(); i++) {
+          const bool eve_wins_spot = state_winners_spot->at(i);
+          const bool eve_wins_hoax = !state_winners_hoax->at(i);
+          nr_diffs += eve_wins_spot != eve_wins_hoax;
+        }
+        const bool same_winners = nr_diffs == 0;
+        std::string diagnostic = "";
+
+        if (!same_winners)
+          diagnostic += "#differences / #states = " + std::to_string(nr_diffs) +
+            " / " + std::to_string(state_winners_hoax->size());
+
+        std::cout << "Winners(spot) == Winners(hoax) : " << same_winners << "\t" << diagnostic << std::endl;
+      }
+
+      const std::string sodd = podd ? "ODD" : "EVEN";
+      const std::string smax = pmax ? "MAX" : "MIN";
+
+      printf ("<%s, %s> %s %s\t%s\t#ACs=%i\t%s\n",
+        smax.c_str(),
+        sodd.c_str(),
+        SOL_STR_COMPUTED.c_str(),
+        SOL_STR_CHECK.c_str(),
+        (std::to_string(hptwa.token->elapsed()) + "s").c_str(),
+        aut->num_sets(),
+        path_in.c_str());
+    }
+
+    if (flag_stats)
+      std::cout << hptwa.stats.to_json(path_in.string(), SOL_STR_COMPUTED,
+                                       hptwa.arena.num_states, hptwa.arena.num_edges) << std::endl;
+
+    if (flag_incremental)
+      incremental_previous = hptwa_ptr;
+  } catch (std::runtime_error &e) {
+    std::cout << "SKIP\t" << e.what() << "\t" << path_in.string() << std::endl;
+  }
+  if (tracer != nullptr)
+    trace_game(path_in, *tracer, std::cout);
+}
+
+/** Solve a single game of a daemon session, see `serve_session`.
+
+    @param[in] pa The parse result of the game
+    @param[in] game The number of the game in its session, starting at 1
+    @param[in] stats The stats of parsing the game
+    @return The result of the game as a single line JSON object
+*/
+static std::string serve_game(const spot::parsed_aut_ptr &pa, const size_t game, hoax::Stats stats) {
+  const std::shared_ptr<hoax::CancelToken> token = arm_game_token();
+  std::string name = "#" + std::to_string(game);
+  if (pa->aut != nullptr) {
+    auto aut_name = pa->aut->get_named_prop<std::string>("automaton-name");
+    if (aut_name != nullptr)
+      name = *aut_name;
+  }
+
+  std::string result = "SKIP";
+  std::string reason;
+  std::string winners;
+  unsigned int num_states = 0, num_edges = 0;
+  std::ostringstream log;
+  /* A skipped game gets its reason from `check_game`. */
+  spot::twa_graph_ptr aut = check_game(pa, name, log, reason);
+  try {
+    if (aut != nullptr && choose_engine(aut, name, stats, log) == hoax::ENGINE_SPOT) {
+      hoax::PhaseTimer timer(stats.time_solve);
+      result = hoax::solve_spot(aut) ? "REAL" : "UNREAL";
+    } else if (aut != nullptr) {
+      hoax::HOAxParityTwA hptwa(aut, token);
+      add_stats_before_expansion(stats, hptwa.stats);
+      hptwa.options.quotient = flag_quotient;
+      hptwa.options.order = flag_order;
+      hptwa.options.sets = flag_sets;
+      hptwa.options.algorithm = flag_algorithm;
+      result = !hptwa.solve_parity_game() ? "REAL" : "UNREAL";
+      if (flag_certify)
+        reason = certify_game(hptwa);
+      stats = hptwa.stats;
+      num_states = hptwa.arena.num_states;
+      num_edges = hptwa.arena.num_edges;
+      /* The source states are never contracted. */
+      if (flag_winners)
+        for (unsigned int state = 0; state < aut->num_states(); state++)
+          winners += hptwa.winners[hptwa.arena_state[state]] ? '1' : '0';
+    }
+  } catch (std::runtime_error &e) {
+    reason = e.what();
+  }
+
+  std::ostringstream os;
+  os << "{\"game\": " << game
+     << ", \"result\": " << hoax::json_string(result);
+  if (!reason.empty())
+    os << ", \"reason\": " << hoax::json_string(reason);
+  if (flag_winners && !winners.empty())
+    os << ", \"winners\": " << hoax::json_string(winners);
+  os << ", \"stats\": " << stats.to_json(name, result, num_states, num_edges) << "}";
+  return os.str();
+}
+
+/** Solve a stream of eHOA games, one after another, until the end of the stream.
+
+    Every game gets its own runtime budget and parity game, so no state of
+    one game survives into the next. Only the bdd_dict and BuDDy's node
+    table, which has grown to fit the largest game so far, are kept.
+
+    @param[in] fd_in The file descriptor to read the games from
+    @param[in] fd_out The file descriptor to write one JSON line per game to
+    @param[in] dict The bdd_dict shared by all games of the daemon
+*/
+static void serve_session(const int fd_in, const int fd_out, const spot::bdd_dict_ptr &dict) {
+  spot::automaton_stream_parser parser(fd_in, "daemon");
+  for (size_t game = 1; ; game++) {
+    hoax::Stats stats;
+    spot::parsed_aut_ptr pa;
+    {
+      hoax::PhaseTimer timer(stats.time_parse);
+      hoax::PerfScope perf(stats.perf_parse);
+      hoax::MemoryScope memory(stats.memory_parse);
+      pa = parser.parse(dict);
+    }
+    /* A missing automaton without errors marks the end of the stream. */
+    if (pa->aut == nullptr && pa->errors.empty())
+      break;
+    if (!hoax::write_all(fd_out, serve_game(pa, game, stats) + "\n"))
+      break;
+  }
+}
+
+/** Run the solver as a long running daemon, see "-D" and "-U".
+
+    Reading from stdin serves a single session. A Unix domain socket serves
+    one connection after another, until the daemon is killed.
+*/
+static void run_daemon() {
+  const spot::bdd_dict_ptr dict = spot::make_bdd_dict();
+  std::cout << std::flush;
+  fflush(stdout);
+
+  if (flag_socket.empty()) {
+    serve_session(STDIN_FILENO, STDOUT_FILENO, dict);
+    return;
+  }
+
+  /* A client that disconnects early must not kill the daemon. */
+  signal(SIGPIPE, SIG_IGN);
+  const int fd = hoax::listen_unix(flag_socket);
+  while (true) {
+    const int client = hoax::accept_unix(fd);
+    serve_session(client, client, dict);
+    close(client);
+  }
+}
 
 int main(int argc, char *argv[]) {
   while (true) {
-    switch (getopt(argc, argv, "hvbds")) {
+    switch (getopt(argc, argv, "hvbdswcj:pSaiqCZo:r:g:e:m:x:DU:Wt:T:")) {
       case 'v':
         flag_verbose = 1;
+        flag_certify = 1;
         continue;
 
       case 'b':
@@ -47,206 +907,208 @@ int main(int argc, char *argv[]) {
         flag_strict = 1;
         continue;
 
-      case 'h': {
-        std::cout << "Usage: hoax [options] [arguments]" << std::endl;
-        std::cout << "Options:" << std::endl;
-        std::cout << "  -h             Show this help message and exit" << std::endl;
-        std::cout << "  -v             Enable verbose output" << std::endl;
-        std::cout << "  -b             Call spot's parity game solver as a baseline comparison" << std::endl;
-        std::cout << "  -d             Dump the original and expanded automata as dot files to the default output dir (" << DEFAULT_DIR_OUT.c_str() << ")" << std::endl;
-        std::cout << "  -s             Run in strict mode; enforce the presence, absence and value of parts of the input automaton" << std::endl;
-        std::cout << "Arguments:" << std::endl;
-        std::cout << "  A space separated list of file paths to eHOA input files of parity games (arenas)" << std::endl;
-        exit(0);
-      }
-    }
-    /* End of options. */
-    break;
-  }
-
-  if (flag_verbose)
-    puts ("verbose flag is set");
+      case 'w':
+        flag_cache_write = 1;
+        continue;
 
-  while (optind < argc) {
-    /* Each game has an individual runtime deadline. */
-    const clock_t start = clock();
-    const clock_t deadline = start + RUNTIME_MAX_SEC * CLOCKS_PER_SEC;
+      case 'c':
+        flag_cache_read = 1;
+        continue;
 
-    std::filesystem::path path_in(argv[optind++]);
+      case 'j':
+        flag_jobs = std::max(1, atoi(optarg));
+        continue;
 
-    /* Ensure the input path exists. */
-    if (!std::filesystem::exists(path_in)) {
-      printf("SKIP\tPATH DOES NOT EXIST\t%s\n", path_in.c_str());
-      continue;
-    }
+      case 'p':
+        flag_pipeline = 1;
+        continue;
 
-    // Parse a HOA file. See
-    // https://spot.lre.epita.fr/doxygen/group__twa__io.html#ga7ddd70d2b02e1234814a2f7fa6afe052
-    spot::parsed_aut_ptr pa = spot::parse_aut(path_in, spot::make_bdd_dict());
-    if (flag_verbose && pa->format_errors(std::cout)) {
-      printf("SKIP\tFORMAT ERR\t%s\n", path_in.c_str());
-      continue;
-    }
-    if (pa->aborted) {
-      printf("SKIP\tABORT\t%s\n", path_in.c_str());
-      continue;
-    }
+      case 'S':
+        flag_stats = 1;
+        continue;
 
-    spot::twa_graph_ptr aut = pa->aut;
-    if (aut == nullptr) {
-      printf("SKIP\tTwA MISSING\t%s\n", path_in.c_str());
-      continue;
-    }
+      case 'a':
+        flag_aiger = 1;
+        continue;
 
-    std::string prop_name;
-    // The "state-player" prop is NOT specified in the benchmarks!
-    // Since it's a spot extension to HOA, our inputs should not have it!
-    prop_name = PROP_SPOT_STATE_PLAYER;
-    auto state_player = aut->get_named_prop<std::vector<bool>>(prop_name);
-    if (flag_strict && state_player != nullptr) {
-      printf("SKIP\tPROP UNEXPECTED %s\t%s\n", prop_name.c_str(), path_in.c_str());
-      continue;
-    }
+      case 'i':
+        flag_incremental = 1;
+        continue;
 
-    // The "state-winner" prop is probably only set by spot after solving
-    // the parity game with its builtin algo?
-    // Since it's a spot extension to HOA, our inputs should not have it!
-    prop_name = PROP_SPOT_STATE_WINNER;
-    auto state_winner = aut->get_named_prop<std::vector<bool>>(prop_name);
-    if (flag_strict && state_winner != nullptr) {
-      printf("SKIP\tPROP UNEXPECTED %s\t%s\n", prop_name.c_str(), path_in.c_str());
-      continue;
-    }
+      case 'q':
+        flag_quotient = 1;
+        continue;
 
-    // The "strategy" prop is probably only set by spot after solving
-    // the parity game with its builtin algo?
-    // Since it's a spot extension to HOA, our inputs should not have it!
-    prop_name = PROP_SPOT_STRAT;
-    auto strategy = aut->get_named_prop<std::vector<unsigned>>(prop_name);
-    if (flag_strict && strategy != nullptr) {
-      printf("SKIP\tPROP UNEXPECTED %s\t%s\n", prop_name.c_str(), path_in.c_str());
-      continue;
-    }
+      case 'C':
+        flag_certify = 1;
+        continue;
 
-    /* The "synthesis-outputs" prop is set by the "controllable-AP" eHOA header.
-      The type of this named prop is `bdd`, NOT `spot::bdd_dict`!
-      That typing mistake cost me hours of debugging ... curse you, inheritance!
+      case 'Z':
+        flag_trace = 1;
+        continue;
 
-      For an example of using the "synthesis-outputs" bdd, see spot source code:
-          https://gitlab.lre.epita.fr/spot/spot/-/blob/next/bin/ltlsynt.cc#L903
+      case 'o':
+        try {
+          flag_order = hoax::parse_vertex_order(optarg);
+        } catch (std::runtime_error &e) {
+          std::cout << e.what() << std::endl;
+          exit(1);
+        }
+        continue;
 
-      The "synthesis-outputs" bdd is a confunction of all controllable APs.
-      i.e.
+      case 'r':
+        try {
+          flag_sets = hoax::parse_set_policy(optarg);
+        } catch (std::runtime_error &e) {
+          std::cout << e.what() << std::endl;
+          exit(1);
+        }
+        continue;
 
-          AP: 4 "a" "b" "c" "d"
-          controllable-AP: 0 2
+      case 'g':
+        try {
+          flag_algorithm = hoax::parse_algorithm(optarg);
+        } catch (std::runtime_error &e) {
+          std::cout << e.what() << std::endl;
+          exit(1);
+        }
+        continue;
 
-      results in a "synthesis-outputs" bdd that represents the propositional
-      formula (a & c).
-     */
-    prop_name = PROP_SPOT_SYNTH_OUTPUT;
-    auto synth_out = aut->get_named_prop<bdd>(prop_name);
-    if (synth_out == nullptr) {
-      printf("SKIP\tPROP MISSING %s\t%s\n", prop_name.c_str(), path_in.c_str());
-      continue;
-    }
+      case 'x':
+        try {
+          flag_export = hoax::parse_export(optarg);
+        } catch (std::runtime_error &e) {
+          std::cout << e.what() << std::endl;
+          exit(1);
+        }
+        continue;
 
-    /* Enforce the automaton types and properties we expect in the benchmarks.
-     */
-    bool pmax, podd;
-    bool isparity = aut->acc().is_parity(pmax, podd);
-    if (flag_strict && !(isparity || aut->acc().is_f() || aut->acc().is_t())) {
-      printf("WARN\tNON-PARITY TwA? '%s'\t%s\n", aut->acc().name().c_str(), path_in.c_str());
-      continue;
-    }
+      case 'e':
+        try {
+          flag_engine = hoax::parse_engine(optarg);
+        } catch (std::runtime_error &e) {
+          std::cout << e.what() << std::endl;
+          exit(1);
+        }
+        continue;
 
+      case 'm':
+        flag_memory_budget = std::max(0.0, atof(optarg));
+        continue;
 
+      case 'D':
+        flag_daemon = 1;
+        continue;
 
-    try {
-      /* FIRST solve using my own implementation, so that I cannot mistake
-          spot's solution for my own. */
-      hoax::HOAxParityTwA hptwa = hoax::HOAxParityTwA(aut, start, deadline);
+      case 'U':
+        flag_daemon = 1;
+        flag_socket = optarg;
+        continue;
 
-      // Call my own implementation of a parity game solver.
-      // If the player we expect to win equals the player that actually wins,
-      // then the game is realizable.
-      const bool SOL_COMPUTED = podd == hptwa.solve_parity_game();
-      const std::string SOL_STR_COMPUTED = SOL_COMPUTED ? "REAL" : "UNREAL";
+      case 'W':
+        flag_winners = 1;
+        continue;
 
-      if (flag_dump) {
-        hptwa.set_state_names();
+      case 't':
+        flag_budget_game = atof(optarg);
+        continue;
 
-        std::filesystem::path ext_path(DEFAULT_DIR_OUT);
-        ext_path.append("EXT_");
+      case 'T':
+        flag_budget_batch = atof(optarg);
+        continue;
 
-        hoax::to_dot(path_in, DEFAULT_DIR_OUT, hptwa.src);
-        hoax::to_dot(path_in, ext_path, hptwa.exp);
+      case 'h': {
+        std::cout << "Usage: hoax [options] [arguments]" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  -h             Show this help message and exit" << std::endl;
+        std::cout << "  -v             Enable verbose output" << std::endl;
+        std::cout << "  -b             With -v, call spot's parity game solver as a baseline comparison instead of checking the certificate" << std::endl;
+        std::cout << "  -d             Dump the original and expanded automata as dot files to the default output dir (" << DEFAULT_DIR_OUT.c_str() << ")" << std::endl;
+        std::cout << "  -x EXPORT      Export every solved arena to the default output dir: csv, binary, scc or ball[:RADIUS[@VERTEX]]" << std::endl;
+        std::cout << "  -s             Run in strict mode; enforce the presence, absence and value of parts of the input automaton, and validate its declared properties" << std::endl;
+        std::cout << "  -w             Write the expanded arenas to the arena cache dir (" << DEFAULT_DIR_CACHE.c_str() << ")" << std::endl;
+        std::cout << "  -c             Load the expanded arenas from the arena cache dir, skipping parsing and expansion (ignored by -a, -b, -d and -v, except with -p)" << std::endl;
+        std::cout << "  -j N           Solve the input files with N isolated worker processes; output stays in input order" << std::endl;
+        std::cout << "  -p             Overlap reading, expanding and solving consecutive input files in a pipeline (no baseline or dumps)" << std::endl;
+        std::cout << "  -S             Print per-phase timings and solver counters as one JSON object per game" << std::endl;
+        std::cout << "  -a             Write a controller of every realizable game as AIGER to the default output dir (not with -p)" << std::endl;
+        std::cout << "  -i             Reuse the expansion and solution of the previous game for related games, e.g. properties of one model (not with -j or -p)" << std::endl;
+        std::cout << "  -q             Solve the bisimulation quotient of every expanded arena, and map the winners back" << std::endl;
+        std::cout << "  -C             Check the winning regions and strategies of every solved arena, and report invalid ones (implied by -v)" << std::endl;
+        std::cout << "  -Z             Write a Chrome trace of every zielonka frame and attractor call to the default output dir, for chrome://tracing or Perfetto" << std::endl;
+        std::cout << "  -o ORDER       Renumber the vertices of every arena before solving: none (default), bfs, rcm or priority" << std::endl;
+        std::cout << "  -r SETS        The vertex sets of the solver: auto (default), tree, vector or bitset" << std::endl;
+        std::cout << "  -g ALGORITHM   The recursive algorithm of the solver: zielonka (default) or parys, which is quasi-polynomial in the worst case" << std::endl;
+        std::cout << "  -e ENGINE      Solve every game with this engine: auto (default), explicit or spot" << std::endl;
+        std::cout << "  -m MB          The memory budget per game; with -e auto, games whose estimated expansion exceeds it are solved by spot (default unlimited)" << std::endl;
+        std::cout << "  -D             Run as a daemon: solve the eHOA games streamed on stdin, and write one JSON line per game to stdout" << std::endl;
+        std::cout << "  -U PATH        Run as a daemon on the Unix domain socket PATH instead, serving one connection after another" << std::endl;
+        std::cout << "  -W             In daemon mode, also return the winner of every source state, 0 for Eve and 1 for Adam" << std::endl;
+        std::cout << "  -t SEC         The wall clock runtime budget per parity game (default " << RUNTIME_MAX_SEC << ")" << std::endl;
+        std::cout << "  -T SEC         The wall clock runtime budget of all parity games together (default unlimited)" << std::endl;
+        std::cout << "Arguments:" << std::endl;
+        std::cout << "  A space separated list of file paths to eHOA input files of parity games (arenas)" << std::endl;
+        exit(0);
       }
+    }
+    /* End of options. */
+    break;
+  }
 
-      /* Print only my own realizability result & input file path. */
-      if (!flag_verbose)
-        std::cout << SOL_STR_COMPUTED.c_str() << "\t"
-                  << (std::to_string((clock() - hptwa.start) / (float)CLOCKS_PER_SEC) + "s").c_str() << "\t"
-                  << path_in.c_str() << std::endl;
-      /* Else, also use spot's result as a baseline. */
-      else {
-      
-        /* Compare against spot's implementation as a baseline.
-
-          Spot's docs state about the arena input that "The arena is a
-          deterministic max odd parity automaton with a 'state-player'
-          property." See
-              https://spot.lre.epita.fr/doxygen/group__games.html#ga5282822f1079cdefc43a1d1b0c83a024
-          However, if an automaton's acceptance condition is not "parity max odd",
-          then the source code for `spot::solve_parity_game()` actually internally
-          transforms the automaton to "parity max even", and solving for "parity max even"
-          in the transformed automaton is equivalent to solving the original acceptance
-          condition in the original/untransformed automaton.
-          That is to say, spot's `spot::solve_parity_game()` outputs which player wins
-          in the initial state (false if even wins, true if odd wins), regardless of the
-          acceptance condition on the original automaton, and without intervention of
-          the caller.
-            https://gitlab.lre.epita.fr/spot/spot/-/blob/next/spot/twaalgos/game.cc#L312
-        */
-        const bool SOL_ACTUAL = podd == spot::solve_parity_game(hptwa.exp);
-        const std::string SOL_STR_ACTUAL = SOL_ACTUAL ? "REAL" : "UNREAL";
-
-        if (flag_verbose) {
-          auto state_winners_spot = hptwa.exp->get_or_set_named_prop<std::vector<bool>>(PROP_SPOT_STATE_WINNER);
-          auto state_winners_hoax = hptwa.exp->get_or_set_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER);
-          const bool same_winners = (*state_winners_spot == *state_winners_hoax);
-          std::string diagnostic = "";
-
-          if (!same_winners) {
-            unsigned int nr_diffs = 0;
-            for (unsigned int i = 0; i < state_winners_spot->size(); i++)
-              nr_diffs += (state_winners_spot->at(i) != state_winners_hoax->at(i));
-            diagnostic += "#differences / #states = " + std::to_string(nr_diffs) +
-              " / " + std::to_string(state_winners_spot->size());
-            if (nr_diffs == state_winners_spot->size())
-              diagnostic += " (Spot and HOAx have inverted winners!)";
-          }
-
-          std::cout << "Winners(spot) == Winners(hoax) : " << same_winners << "\t" << diagnostic << std::endl;
-        }
+  /* The previous game is only known when the games are solved one after
+    another, in a single process. */
+  if (flag_incremental && (flag_jobs > 1 || flag_pipeline)) {
+    std::cout << "The flag -i cannot be combined with -j or -p" << std::endl;
+    exit(1);
+  }
 
-        const std::string sodd = podd ? "ODD" : "EVEN";
-        const std::string smax = pmax ? "MAX" : "MIN";
-
-        printf ("<%s, %s> %s %s\t%s\t#ACs=%i\t%s\n",
-          smax.c_str(),
-          sodd.c_str(),
-          SOL_STR_COMPUTED.c_str(),
-          SOL_STR_ACTUAL.c_str(),
-          (std::to_string((clock() - hptwa.start) / (float)CLOCKS_PER_SEC) + "s").c_str(),
-          aut->num_sets(),
-          path_in.c_str());
-      }
+  if (flag_verbose)
+    puts ("verbose flag is set");
+
+  /* A non-positive game budget means the default budget. */
+  if (flag_budget_game <= 0)
+    flag_budget_game = RUNTIME_MAX_SEC;
+  /* The batch budget starts now, and is shared by all workers. */
+  if (flag_budget_batch > 0)
+    batch_deadline = hoax::budget_clock::now() +
+      std::chrono::duration_cast<hoax::budget_clock::duration>(std::chrono::duration<double>(flag_budget_batch));
+
+  /* Collect the input files; the batch workers pull them in this order. */
+  std::vector<std::filesystem::path> paths_in(argv + optind, argv + argc);
+
+  if (flag_daemon) {
+    try {
+      run_daemon();
     } catch (std::runtime_error &e) {
-      std::cout << "SKIP\t" << e.what() << "\t" << path_in.string() << std::endl;
+      std::cout << e.what() << std::endl;
+      return 1;
     }
+  } else if (flag_jobs > 1) {
+    /* BDD state in spot/BuDDy is global, so isolate every game in its own
+      process. Each process has its own deadline and memory accounting. */
+    fflush(stdout);
+    hoax::run_batch(paths_in.size(), flag_jobs,
+      [&paths_in](const size_t job) { solve_file(paths_in[job]); },
+      [&paths_in](const size_t job, const hoax::BatchResult &result) {
+        std::cout << result.output;
+        if (!WIFEXITED(result.status) || WEXITSTATUS(result.status) != 0)
+          std::cout << "SKIP\tCRASHED (" << hoax::describe_status(result.status) << ")\t"
+                    << paths_in[job].string() << std::endl;
+        if (flag_verbose)
+          std::cout << "Peak RSS: " << result.usage.ru_maxrss << " KiB\t"
+                    << paths_in[job].string() << std::endl;
+      });
+  } else if (flag_pipeline) {
+    solve_pipeline(paths_in);
+  } else {
+    for (const auto &path_in : paths_in)
+      solve_file(path_in);
+    /* Release all BDDs before spot's static state is destroyed. */
+    incremental_previous = nullptr;
+    incremental_dict = nullptr;
   }
 
 
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef HOAX_TESTS_FIXTURES_H
+#define HOAX_TESTS_FIXTURES_H
+
+#include "arena.h"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <random>
+#include <set>
+#include <vector>
+
+/** Build a "parity max even" arena from the successors of every vertex.
+
+    @param[in] successors The successors of every vertex
+    @param[in] owners The owner of every vertex, true iff. the "odd player"
+    @param[in] priorities The priority of every vertex
+    @param[in] init_state The initial vertex
+    @param[in] num_sets The number of acceptance sets
+*/
+inline hoax::Arena make_graph_arena(const std::vector<std::vector<uint32_t>> &successors,
+                                    const std::vector<bool> &owners, const std::vector<int> &priorities,
+                                    const unsigned int init_state, const unsigned int num_sets) {
+  std::vector<uint32_t> offsets = {0};
+  std::vector<uint32_t> targets;
+  for (const std::vector<uint32_t> &succ : successors) {
+    targets.insert(targets.end(), succ.begin(), succ.end());
+    offsets.push_back(targets.size());
+  }
+  return hoax::make_arena(std::move(offsets), std::move(targets), owners, priorities,
+                          init_state, true, false, num_sets);
+}
+
+/** Build the arena
+      0 -> {1, 2}, 1 -> {0}, 2 -> {2}
+    where 0 is an "odd player" state and 1, 2 are "even player" states. */
+inline hoax::Arena make_test_arena(const std::vector<int> &priorities = {INT_MIN + 1, 2, 1}) {
+  return make_graph_arena({{1, 2}, {0}, {2}}, {true, false, false}, priorities, 0, 3);
+}
+
+/** Build a random arena with the given number of vertices and priorities,
+    where every vertex has between 1 and 3 successors. */
+inline hoax::Arena make_random_arena(const unsigned int num_vertices, const unsigned int num_priorities,
+                                     const bool parity_max, std::mt19937 &rng) {
+  std::vector<uint32_t> offsets = {0};
+  std::vector<uint32_t> targets;
+  std::vector<bool> owners(num_vertices);
+  std::vector<int> priorities(num_vertices);
+  for (unsigned int v = 0; v < num_vertices; v++) {
+    owners[v] = rng() % 2;
+    priorities[v] = rng() % num_priorities;
+    std::set<uint32_t> successors;
+    const unsigned int degree = std::min<unsigned int>(1 + rng() % 3, num_vertices);
+    while (successors.size() < degree)
+      successors.insert(rng() % num_vertices);
+    targets.insert(targets.end(), successors.begin(), successors.end());
+    offsets.push_back(targets.size());
+  }
+  return hoax::make_arena(std::move(offsets), std::move(targets), owners, priorities,
+                          0, parity_max, false, num_priorities);
+}
+
+/** Check whether two arenas have the same vertices, owners and edges. */
+inline bool same_graph(const hoax::Arena &a1, const hoax::Arena &a2) {
+  if (a1.num_states != a2.num_states || a1.num_edges != a2.num_edges || a1.init_state != a2.init_state)
+    return false;
+  for (unsigned int state = 0; state < a1.num_states; state++) {
+    auto s1 = a1.successors(state);
+    auto s2 = a2.successors(state);
+    if (a1.owner(state) != a2.owner(state) ||
+        std::vector<uint32_t>(s1.begin(), s1.end()) != std::vector<uint32_t>(s2.begin(), s2.end()))
+      return false;
+  }
+  return true;
+}
+
+/** Assert that two arenas describe the same parity game. */
+inline void assert_same_arena(const hoax::Arena &a1, const hoax::Arena &a2) {
+  assert(same_graph(a1, a2));
+  assert(a1.parity_max == a2.parity_max);
+  assert(a1.parity_odd == a2.parity_odd);
+  assert(a1.num_sets == a2.num_sets);
+  for (unsigned int state = 0; state < a1.num_states; state++)
+    assert(a1.priority(state) == a2.priority(state));
+}
+
+#endif
@@ -0,0 +1,256 @@
+#include "aiger.h"
+#include "hoax.h"
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <map>
+
+int test_structural_hashing() {
+  hoax::AIG aig({"a", "b"}, {"state_0"});
+  const unsigned int a = aig.input(0);
+  const unsigned int b = aig.input(1);
+  const unsigned int l = aig.latch(0);
+  assert(a == 2 && b == 4 && l == 6);
+
+  /* Trivial gates are folded away. */
+  assert(aig.make_and(a, AIG_TRUE) == a);
+  assert(aig.make_and(AIG_FALSE, b) == AIG_FALSE);
+  assert(aig.make_and(a, a) == a);
+  assert(aig.make_and(a, a ^ 1) == AIG_FALSE);
+  assert(aig.make_ite(l, AIG_TRUE, AIG_FALSE) == l);
+  assert(aig.make_ite(l, a, a) == a);
+  assert(aig.num_ands() == 0);
+
+  /* The same gate is only created once, regardless of the operand order. */
+  const unsigned int ab = aig.make_and(a, b);
+  assert(ab == 8);
+  assert(aig.make_and(b, a) == ab);
+  assert(aig.make_or(a ^ 1, b ^ 1) == (ab ^ 1));
+  assert(aig.num_ands() == 1);
+
+  /* A multiplexer takes three gates. */
+  aig.make_ite(l, a, b);
+  assert(aig.num_ands() == 4);
+
+  return 0;
+}
+
+int test_write_aag() {
+  /* A toggle flip-flop that outputs whether an odd number of "a" were seen. */
+  hoax::AIG aig({"a"}, {"state_0"});
+  const unsigned int next = aig.make_ite(aig.input(0), aig.latch(0) ^ 1, aig.latch(0));
+  aig.set_latch_next(0, next);
+  aig.add_output(aig.latch(0), "odd");
+
+  std::ostringstream out;
+  aig.write_aag(out, "toggle");
+  const std::string expected =
+    "aag 5 1 1 1 3\n"
+    "2\n"
+    "4 11\n"
+    "4\n"
+    "6 5 2\n"
+    "8 4 3\n"
+    "10 9 7\n"
+    "i0 a\n"
+    "l0 state_0\n"
+    "o0 odd\n"
+    "c\n"
+    "toggle\n";
+  assert(out.str() == expected);
+
+  return 0;
+}
+
+/** A circuit, read back from the ASCII AIGER format. */
+struct Circuit {
+  unsigned int num_inputs = 0;
+  std::vector<unsigned int> latch_next;
+  std::vector<unsigned int> outputs;
+  /** The left hand side and both operands of every AND gate. */
+  std::vector<std::vector<unsigned int>> ands;
+
+  /** Evaluate the circuit for a single step.
+
+      @param[in] inputs The value of every input
+      @param[in,out] latches The value of every latch, replaced by the next one
+      @return The value of every output
+  */
+  std::vector<bool> step(const std::vector<bool> &inputs, std::vector<bool> &latches) const {
+    std::vector<bool> values(1 + this->num_inputs + latches.size() + this->ands.size(), false);
+    for (size_t i = 0; i < inputs.size(); i++)
+      values[1 + i] = inputs[i];
+    for (size_t l = 0; l < latches.size(); l++)
+      values[1 + this->num_inputs + l] = latches[l];
+    auto value = [&values](const unsigned int lit) -> bool { return values[lit >> 1] ^ (lit & 1); };
+    for (const auto &gate : this->ands)
+      values[gate[0] >> 1] = value(gate[1]) && value(gate[2]);
+
+    std::vector<bool> outputs;
+    for (const unsigned int lit : this->outputs)
+      outputs.push_back(value(lit));
+    for (size_t l = 0; l < latches.size(); l++)
+      latches[l] = value(this->latch_next[l]);
+    return outputs;
+  }
+};
+
+Circuit read_aag(const std::string &aag) {
+  std::istringstream in(aag);
+  std::string magic;
+  unsigned int max_var, num_inputs, num_latches, num_outputs, num_ands;
+  in >> magic >> max_var >> num_inputs >> num_latches >> num_outputs >> num_ands;
+  assert(magic == "aag" && max_var == num_inputs + num_latches + num_ands);
+
+  Circuit circuit;
+  circuit.num_inputs = num_inputs;
+  unsigned int lit;
+  for (unsigned int i = 0; i < num_inputs; i++)
+    in >> lit;
+  circuit.latch_next.resize(num_latches);
+  for (unsigned int l = 0; l < num_latches; l++)
+    in >> lit >> circuit.latch_next[l];
+  circuit.outputs.resize(num_outputs);
+  for (unsigned int o = 0; o < num_outputs; o++)
+    in >> circuit.outputs[o];
+  circuit.ands.assign(num_ands, std::vector<unsigned int>(3));
+  for (unsigned int a = 0; a < num_ands; a++)
+    in >> circuit.ands[a][0] >> circuit.ands[a][1] >> circuit.ands[a][2];
+  return circuit;
+}
+
+/** Build the game with controllable AP "c" and uncontrollable APs "u", "v":
+      0 -[u & c]-> 1 {2},  0 -[u & !c]-> 0 {1},  0 -[c & !u]-> 0 {0},  0 -[!(u | c)]-> 2 {1},
+      1 -[c & !v]-> 1 {1},  1 -[!(v | c)]-> 3 {2},
+      2 -[t]-> 2 {1},
+      3 -[t]-> 0 {0}
+    under the "parity max even 3" condition. Eve wins by moving from 0 to 1
+    on "u" and staying in 0 on "!u", and by moving from 1 to 3. Both
+    "even player" states of 0, and the one of 1, have edges of different
+    priorities, those of 2 and 3 are contracted, and "v" leaves 1 without
+    a move. */
+spot::twa_graph_ptr make_game() {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  const bdd v = bdd_ithvar(aut->register_ap("v"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(3, spot::acc_cond::acc_code::parity_max_even(3));
+
+  aut->new_states(4);
+  aut->set_init_state(0);
+  aut->new_edge(0, 1, u & c, {2});
+  aut->new_edge(0, 0, u & !c, {1});
+  aut->new_edge(0, 0, c & !u, {0});
+  aut->new_edge(0, 2, !(u | c), {1});
+  aut->new_edge(1, 1, c & !v, {1});
+  aut->new_edge(1, 3, !(v | c), {2});
+  aut->new_edge(2, 2, bddtrue, {1});
+  aut->new_edge(3, 0, bddtrue, {0});
+  return aut;
+}
+
+int test_synthesize_controller() {
+  const spot::twa_graph_ptr aut = make_game();
+  hoax::HOAxParityTwA hptwa(aut, std::make_shared<hoax::CancelToken>());
+  assert(hptwa.stats.evals_skipped == 1);
+  assert(hptwa.stats.eve_contracted == 2);
+  assert(hptwa.solve_parity_game() == PEVEN);
+
+  const hoax::AIG aig = hoax::synthesize_controller(hptwa);
+  assert(aig.num_inputs() == 2 && aig.num_outputs() == 1);
+  std::ostringstream out;
+  aig.write_aag(out);
+  assert(out.str().find("i0 u\ni1 v\n") != std::string::npos);
+  assert(out.str().find("o0 c\n") != std::string::npos);
+  const Circuit circuit = read_aag(out.str());
+
+  const spot::bdd_dict_ptr dict = aut->get_dict();
+  const int var_c = dict->varnum(spot::formula::ap("c"));
+  const int var_u = dict->varnum(spot::formula::ap("u"));
+  const int var_v = dict->varnum(spot::formula::ap("v"));
+
+  /* Repeat every input word of up to as many letters as there are states
+    forever, and run the circuit alongside the automaton. The run of a
+    repeated word is a lasso, whose loop starts when the latches and the
+    state at the start of the word repeat. */
+  const unsigned int num_letters = 4;
+  bool skipped = false;
+  for (unsigned int length = 1; length <= aut->num_states(); length++) {
+    unsigned int num_words = 1;
+    for (unsigned int i = 0; i < length; i++)
+      num_words *= num_letters;
+
+    for (unsigned int word = 0; word < num_words; word++) {
+      std::vector<bool> latches(circuit.latch_next.size(), false);
+      unsigned int state = aut->get_init_state_number();
+      /* The latches and state at the start of every repetition, and the
+        most significant priority seen during it. */
+      std::map<std::pair<std::vector<bool>, unsigned int>, size_t> starts;
+      std::vector<int> seen;
+      /* The latches encode the source state. */
+      std::map<std::vector<bool>, unsigned int> decode;
+
+      bool stuck = false;
+      while (!stuck && starts.emplace(std::make_pair(latches, state), seen.size()).second) {
+        int most = INT_MIN;
+        for (unsigned int i = 0, letter = word; i < length && !stuck; i++, letter /= num_letters) {
+          assert(decode.emplace(latches, state).first->second == state);
+          const bool u = letter % num_letters & 1;
+          const bool v = letter % num_letters & 2;
+          const bdd input = (u ? bdd_ithvar(var_u) : bdd_nithvar(var_u)) &
+                            (v ? bdd_ithvar(var_v) : bdd_nithvar(var_v));
+
+          /* An input without any move of the automaton leaves the game. */
+          bool enabled = false;
+          for (auto &edge : aut->out(state))
+            enabled |= (edge.cond & input) != bddfalse;
+          if (!enabled) {
+            stuck = skipped = true;
+            break;
+          }
+
+          const std::vector<bool> output = circuit.step({u, v}, latches);
+          const bdd letter_cube = input & (output[0] ? bdd_ithvar(var_c) : bdd_nithvar(var_c));
+          int dst = -1;
+          for (auto &edge : aut->out(state))
+            if ((edge.cond & letter_cube) != bddfalse) {
+              dst = edge.dst;
+              most = std::max(most, hoax::priority(edge.acc, true, false, 3));
+            }
+          /* The controller only takes enabled edges. */
+          assert(dst >= 0);
+          state = dst;
+        }
+        seen.push_back(most);
+      }
+      if (stuck)
+        continue;
+
+      /* The loop of the lasso is accepting. */
+      int most = INT_MIN;
+      for (size_t i = starts.at(std::make_pair(latches, state)); i < seen.size(); i++)
+        most = std::max(most, seen[i]);
+      assert(most >= 0 && most % 2 == 0);
+    }
+  }
+  assert(skipped);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_structural_hashing();
+  if (ret) return ret;
+
+  ret = test_write_aag();
+  if (ret) return ret;
+
+  ret = test_synthesize_controller();
+  if (ret) return ret;
+
+  return 0;
+}
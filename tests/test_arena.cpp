@@ -0,0 +1,146 @@
+#include "arena.h"
+#include "fixtures.h"
+#include <cassert>
+#include <fstream>
+#include <climits>
+#include <array>
+#include <cstring>
+#include <iterator>
+
+int test_arena() {
+  hoax::Arena arena = make_test_arena({INT_MIN + 1, 4, 1});
+
+  /* Test the CSR successor ranges. */
+  assert(arena.successors(0).size() == 2);
+  assert(*arena.successors(0).begin() == 1);
+  assert(arena.successors(1).size() == 1);
+  assert(*arena.successors(2).begin() == 2);
+
+  /* Test the owner bits and the priority decompression. */
+  assert(arena.owner(0) && !arena.owner(1) && !arena.owner(2));
+  assert(arena.priority(0) == INT_MIN + 1);
+  assert(arena.priority(1) == 4);
+  assert(arena.priority(2) == 1);
+  assert(arena.num_priorities == 3);
+  assert(arena.priority_width == 1);
+
+  /* Many distinct priorities require a wider priority index. */
+  std::vector<uint32_t> offsets(1001, 0);
+  std::vector<bool> owners(1000, false);
+  std::vector<int> priorities(1000);
+  for (unsigned int i = 0; i < 1000; i++)
+    priorities[i] = 1000 - i;
+  hoax::Arena wide = hoax::make_arena(std::move(offsets), {}, owners, priorities, 0, false, true, 1);
+  assert(wide.priority_width == 2);
+  for (unsigned int i = 0; i < 1000; i++)
+    assert(wide.priority(i) == priorities[i]);
+
+  return 0;
+}
+
+/** Copy a cache file with the first 8 byte aligned occurrence of a value replaced.
+
+    @param[in] bytes The content of the cache file
+    @param[in] path The path to write the copy to
+    @param[in] from The value to replace
+    @param[in] to The replacement value
+    @param[in] size The number of bytes to keep from the content
+*/
+template<typename T>
+void write_patched(std::string bytes, const std::filesystem::path &path,
+                   const T from, const T to, const size_t size) {
+  size_t pos = 0;
+  while (pos + sizeof(T) <= bytes.size() && std::memcmp(bytes.data() + pos, &from, sizeof(T)) != 0)
+    pos += 8;
+  assert(pos + sizeof(T) <= bytes.size());
+  std::memcpy(bytes.data() + pos, &to, sizeof(T));
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(bytes.data(), size);
+}
+
+int test_arena_cache(const std::string &dir_out) {
+  const std::filesystem::path path_in = dir_out + "/test_arena_source.ehoa";
+  const std::filesystem::path dir_cache = dir_out + "/cache";
+
+  /* The cache is keyed on the content of the source file. */
+  {
+    std::ofstream source(path_in);
+    source << "HOA: v1" << std::endl;
+  }
+  const uint64_t hash = hoax::file_hash(path_in);
+  const std::filesystem::path path_cache = hoax::arena_cache_path(dir_cache, path_in);
+
+  hoax::Arena arena = make_test_arena({INT_MIN + 1, 4, 1});
+  hoax::write_arena(path_cache, arena, hash);
+
+  /* Test the round trip through the cache file. */
+  std::optional<hoax::Arena> mapped = hoax::map_arena(path_cache, hash);
+  assert(mapped.has_value());
+  assert_same_arena(arena, *mapped);
+
+  /* Truncated and corrupted cache files are cache misses. */
+  std::string bytes;
+  {
+    std::ifstream in(path_cache, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  const uint64_t file_size = bytes.size();
+  const std::filesystem::path path_corrupt = dir_cache / "corrupt.hoaxa";
+  write_patched<uint64_t>(bytes, path_corrupt, file_size, file_size, file_size / 2);
+  assert(!hoax::map_arena(path_corrupt, hash).has_value());
+  /* Even when the recorded size agrees, the last section must fit. */
+  write_patched<uint64_t>(bytes, path_corrupt, file_size, file_size - 8, file_size - 8);
+  assert(!hoax::map_arena(path_corrupt, hash).has_value());
+  /* The edge target 0 -> 2 becomes 0 -> 7. */
+  using Words = std::array<uint32_t, 4>;
+  write_patched<Words>(bytes, path_corrupt, {1, 2, 0, 2}, {1, 7, 0, 2}, file_size);
+  assert(!hoax::map_arena(path_corrupt, hash).has_value());
+  /* The last offset must be the number of edges. */
+  write_patched<Words>(bytes, path_corrupt, {0, 2, 3, 4}, {0, 2, 3, 5}, file_size);
+  assert(!hoax::map_arena(path_corrupt, hash).has_value());
+  /* A priority code must index the table {INT_MIN + 1, 1, 4}, the one byte
+    codes {0, 2, 1} of the states become {0, 2, 3}. */
+  using Codes = std::array<uint8_t, 8>;
+  write_patched<Codes>(bytes, path_corrupt, {0, 2, 1}, {0, 2, 3}, file_size);
+  assert(!hoax::map_arena(path_corrupt, hash).has_value());
+  /* The copy without changes still maps. */
+  write_patched<uint64_t>(bytes, path_corrupt, file_size, file_size, file_size);
+  assert(hoax::map_arena(path_corrupt, hash).has_value());
+
+  /* Changing the source file content must invalidate the cache. */
+  {
+    std::ofstream source(path_in, std::ios::app);
+    source << "States: 3" << std::endl;
+  }
+  const uint64_t hash_changed = hoax::file_hash(path_in);
+  assert(hash_changed != hash);
+  assert(!hoax::map_arena(path_cache, hash_changed).has_value());
+
+  /* Inputs with the same name in different directories have their own cache file. */
+  assert(hoax::arena_cache_path(dir_cache, dir_out + "/a/game.ehoa") !=
+         hoax::arena_cache_path(dir_cache, dir_out + "/b/game.ehoa"));
+  assert(hoax::arena_cache_path(dir_cache, dir_out + "/a/game.ehoa") ==
+         hoax::arena_cache_path(dir_cache, dir_out + "/a/./game.ehoa"));
+
+  /* A missing cache file is a cache miss, not an error. */
+  assert(!hoax::map_arena(dir_cache / "missing.hoaxa", hash).has_value());
+
+  std::filesystem::remove(path_in);
+  std::filesystem::remove_all(dir_cache);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  assert(argc >= 2);  // Require the output path.
+  std::string dir_out = argv[1];
+  int ret = 0;
+
+  ret = test_arena();
+  if (ret) return ret;
+
+  ret = test_arena_cache(dir_out);
+  if (ret) return ret;
+
+  return 0;
+}
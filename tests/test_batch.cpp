@@ -0,0 +1,64 @@
+#include "batch.h"
+#include <cassert>
+#include <iostream>
+#include <unistd.h>
+#include <vector>
+
+int test_batch_order() {
+  const size_t num_jobs = 8;
+  std::vector<size_t> reported;
+
+  /* Early jobs take longest, so they finish last; the reports must still
+    arrive in job order, each with only its own output. */
+  hoax::run_batch(num_jobs, 4,
+    [](const size_t job) {
+      usleep((num_jobs - job) * 20000);
+      std::cout << "job " << job << std::endl;
+    },
+    [&reported](const size_t job, const hoax::BatchResult &result) {
+      assert(WIFEXITED(result.status) && WEXITSTATUS(result.status) == 0);
+      assert(result.output == "job " + std::to_string(job) + "\n");
+      reported.push_back(job);
+    });
+
+  assert(reported.size() == num_jobs);
+  for (size_t job = 0; job < num_jobs; job++)
+    assert(reported[job] == job);
+
+  return 0;
+}
+
+int test_batch_isolation() {
+  /* A crashing job may not affect the other jobs. */
+  std::vector<int> statuses;
+  hoax::run_batch(3, 2,
+    [](const size_t job) {
+      if (job == 1) abort();
+      std::cout << job;
+    },
+    [&statuses](const size_t job, const hoax::BatchResult &result) {
+      if (job != 1) assert(result.output == std::to_string(job));
+      statuses.push_back(result.status);
+    });
+
+  assert(statuses.size() == 3);
+  assert(WIFEXITED(statuses[0]) && WEXITSTATUS(statuses[0]) == 0);
+  assert(WIFSIGNALED(statuses[1]));
+  assert(hoax::describe_status(statuses[1]) == "signal " + std::to_string(SIGABRT));
+  assert(WIFEXITED(statuses[2]) && WEXITSTATUS(statuses[2]) == 0);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_batch_order();
+  if (ret) return ret;
+
+  ret = test_batch_isolation();
+  if (ret) return ret;
+
+  return 0;
+}
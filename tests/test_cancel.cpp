@@ -0,0 +1,85 @@
+#include "cancel.h"
+#include <cassert>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+
+/** Busy wait until the token is cancelled, or the timeout passes. */
+bool wait_cancelled(const hoax::CancelToken &token, const hoax::budget_clock::duration timeout) {
+  const auto until = hoax::budget_clock::now() + timeout;
+  while (!token.cancelled() && hoax::budget_clock::now() < until);
+  return token.cancelled();
+}
+
+int test_game_budget() {
+  hoax::Watchdog watchdog;
+
+  /* A short budget is cancelled by the watchdog, a long one is not. */
+  auto token_short = watchdog.arm(20ms);
+  auto token_long = watchdog.arm(1h);
+  assert(wait_cancelled(*token_short, 5s));
+  assert(!token_long->cancelled());
+
+  /* A cancelled token throws on check. */
+  bool thrown = false;
+  try {
+    token_short->check();
+  } catch (std::runtime_error &e) {
+    thrown = true;
+  }
+  assert(thrown);
+  token_long->check();
+
+  /* The first cancellation reason sticks. */
+  token_long->cancel(hoax::CancelToken::MANUAL);
+  token_long->cancel(hoax::CancelToken::GAME_BUDGET);
+  assert(token_long->cancelled());
+
+  return 0;
+}
+
+int test_resumed_budget() {
+  hoax::Watchdog watchdog;
+
+  /* A resumed budget counts the time spent before ... */
+  auto token_resumed = watchdog.arm(1h, 10min);
+  assert(token_resumed->elapsed() >= 600);
+  assert(!token_resumed->cancelled());
+
+  /* ... and is cancelled once the rest of it runs out. */
+  auto token_spent = watchdog.arm(30ms, 10ms);
+  assert(wait_cancelled(*token_spent, 5s));
+
+  return 0;
+}
+
+int test_batch_budget() {
+  hoax::Watchdog watchdog;
+  auto token = watchdog.arm(1h);
+  watchdog.set_batch_deadline(hoax::budget_clock::now() + 20ms);
+
+  /* The batch deadline cancels every armed token ... */
+  assert(wait_cancelled(*token, 5s));
+
+  /* ... and every token armed afterwards. */
+  auto token_late = watchdog.arm(1h);
+  assert(token_late->cancelled());
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_game_budget();
+  if (ret) return ret;
+
+  ret = test_resumed_budget();
+  if (ret) return ret;
+
+  ret = test_batch_budget();
+  if (ret) return ret;
+
+  return 0;
+}
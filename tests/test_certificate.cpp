@@ -0,0 +1,55 @@
+#include "hoax.h"
+#include "certificate.h"
+#include "fixtures.h"
+#include <cassert>
+#include <climits>
+
+int test_valid_certificate() {
+  /* The "odd player" moves to the odd self loop of 2, and wins everywhere. */
+  hoax::Arena arena = make_test_arena({INT_MIN + 1, 2, 1});
+  assert(hoax::check_solution(arena, {true, true, true}, {2, -1, -1}).empty());
+
+  /* The solver's own solution must be a valid certificate. */
+  hoax::HOAxParityTwA hptwa(arena, std::make_shared<hoax::CancelToken>());
+  assert(hptwa.solve_parity_game() == PODD);
+  assert(hoax::check_solution(arena, hptwa.winners, hptwa.strategy).empty());
+
+  /* With only even priorities, the "even player" wins everywhere. */
+  hoax::Arena arena_even = make_test_arena({INT_MIN + 1, 2, 4});
+  hoax::HOAxParityTwA hptwa_even(arena_even, std::make_shared<hoax::CancelToken>());
+  assert(hptwa_even.solve_parity_game() == PEVEN);
+  assert(hoax::check_solution(arena_even, hptwa_even.winners, hptwa_even.strategy).empty());
+
+  return 0;
+}
+
+int test_invalid_certificate() {
+  hoax::Arena arena = make_test_arena({INT_MIN + 1, 2, 1});
+
+  /* The cycle 0 -> 1 -> 0 has the even priority 2. */
+  assert(!hoax::check_solution(arena, {true, true, true}, {1, -1, -1}).empty());
+  /* No strategy, or a strategy that is not a successor. */
+  assert(!hoax::check_solution(arena, {true, true, true}, {-1, -1, -1}).empty());
+  assert(!hoax::check_solution(arena, {true, true, true}, {0, -1, -1}).empty());
+  /* The "odd player" escapes from 0 to 2. */
+  assert(!hoax::check_solution(arena, {false, false, true}, {-1, 0, 2}).empty());
+  /* The "even player" wins 2 with an odd self loop. */
+  assert(!hoax::check_solution(arena, {true, true, false}, {2, -1, 2}).empty());
+  /* The solution must cover every vertex. */
+  assert(!hoax::check_solution(arena, {true, true}, {2, -1}).empty());
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_valid_certificate();
+  if (ret) return ret;
+
+  ret = test_invalid_certificate();
+  if (ret) return ret;
+
+  return 0;
+}
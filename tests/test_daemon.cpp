@@ -0,0 +1,89 @@
+#include "daemon.h"
+#include <cassert>
+#include <csignal>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/** Read from a file descriptor until the other end is closed. */
+std::string read_all(const int fd) {
+  std::string data;
+  char buffer[256];
+  ssize_t n;
+  while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+    data.append(buffer, n);
+  return data;
+}
+
+int test_write_all() {
+  int fds[2];
+  assert(pipe(fds) == 0);
+
+  /* More than a pipe buffer, so the writes are short. */
+  const std::string data(1 << 20, 'x');
+  std::thread writer([&]() {
+    assert(hoax::write_all(fds[1], data));
+    close(fds[1]);
+  });
+  assert(read_all(fds[0]) == data);
+  writer.join();
+
+  /* Writing to a closed pipe fails instead of raising SIGPIPE. */
+  signal(SIGPIPE, SIG_IGN);
+  close(fds[0]);
+  assert(pipe(fds) == 0);
+  close(fds[0]);
+  assert(!hoax::write_all(fds[1], "x"));
+  close(fds[1]);
+
+  return 0;
+}
+
+int test_unix_socket() {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() /
+    ("hoax_test_" + std::to_string(getpid()) + ".sock");
+  const int fd = hoax::listen_unix(path);
+
+  std::thread client([&]() {
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    const int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    assert(connect(sock, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0);
+    assert(hoax::write_all(sock, "game"));
+    shutdown(sock, SHUT_WR);
+    assert(read_all(sock) == "result");
+    close(sock);
+  });
+
+  /* The daemon side echoes a result per request. */
+  const int conn = hoax::accept_unix(fd);
+  assert(read_all(conn) == "game");
+  assert(hoax::write_all(conn, "result"));
+  close(conn);
+  client.join();
+  close(fd);
+
+  /* A stale socket file is replaced. */
+  const int fd2 = hoax::listen_unix(path);
+  close(fd2);
+  std::filesystem::remove(path);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_write_all();
+  if (ret) return ret;
+
+  ret = test_unix_socket();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include "hoax.h"
+#include "dense.h"
+#include "certificate.h"
+#include "fixtures.h"
+#include <cassert>
+#include <random>
+
+int test_dense_arena() {
+  /* The arena 0 -> {1, 70}, 1 -> {0}, ..., spanning two words per row. */
+  std::vector<uint32_t> offsets = {0, 2};
+  std::vector<uint32_t> targets = {1, 70};
+  for (uint32_t v = 1; v < 71; v++) {
+    targets.push_back(0);
+    offsets.push_back(targets.size());
+  }
+  hoax::Arena arena = hoax::make_arena(std::move(offsets), std::move(targets),
+                                       std::vector<bool>(71, false), std::vector<int>(71, 0),
+                                       0, true, false, 1);
+  assert(hoax::DenseArena::fits(arena));
+
+  hoax::DenseArena dense(arena);
+  assert(dense.words() == 2);
+  assert(dense.row(0)[0] == uint64_t(1) << 1);
+  assert(dense.row(0)[1] == uint64_t(1) << 6);
+  assert(dense.row(70)[0] == 1 && dense.row(70)[1] == 0);
+
+  return 0;
+}
+
+int test_attractor_dense() {
+  std::mt19937 rng(1);
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  for (unsigned int trial = 0; trial < 100; trial++) {
+    hoax::Arena arena = make_random_arena(2 + rng() % 150, 5, rng() % 2, rng);
+    hoax::HOAxParityTwA aut(arena, token);
+    aut.dense = std::make_shared<const hoax::DenseArena>(arena);
+    aut.strategy.assign(arena.num_states, -1);
+
+    /* A random sub-arena, and a random target inside of it. */
+    std::set<int> vertices_all, vertices_odd, vertices_even, target;
+    for (unsigned int v = 0; v < arena.num_states; v++) {
+      if (rng() % 4 == 0)
+        continue;
+      vertices_all.insert(v);
+      (arena.owner(v) ? vertices_odd : vertices_even).insert(v);
+      if (rng() % 8 == 0)
+        target.insert(v);
+    }
+
+    /* The dense attractor is the sparse one, and every attracted vertex of
+      the player moves to an attracted vertex. */
+    for (const unsigned int player : {PEVEN, PODD}) {
+      const std::set<int> attr = hoax::attractor_dense(vertices_all, aut, target, player);
+      assert(attr == hoax::attractor(vertices_all, vertices_odd, vertices_even, aut, target, player));
+      for (const int v : attr)
+        if (!hoax::contains(target, v) && arena.owner(v) == (player == PODD))
+          assert(hoax::contains(attr, aut.strategy[v]));
+    }
+  }
+
+  return 0;
+}
+
+int test_solve_dense() {
+  std::mt19937 rng(2);
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  for (unsigned int trial = 0; trial < 100; trial++) {
+    hoax::Arena arena = make_random_arena(2 + rng() % 60, 5, rng() % 2, rng);
+    hoax::HOAxParityTwA sparse(arena, token);
+    sparse.options.sets = hoax::SETS_TREE;
+    const bool winner = sparse.solve_parity_game();
+    assert(sparse.dense == nullptr);
+
+    /* Small arenas are solved with the dense attractor by default. */
+    hoax::HOAxParityTwA dense(arena, token);
+    assert(dense.solve_parity_game() == winner);
+    assert(dense.dense != nullptr);
+    assert(dense.stats.edges_scanned == 0);
+    assert(dense.winners == sparse.winners);
+    assert(hoax::check_solution(arena, dense.winners, dense.strategy).empty());
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_dense_arena();
+  if (ret) return ret;
+
+  ret = test_attractor_dense();
+  if (ret) return ret;
+
+  ret = test_solve_dense();
+  if (ret) return ret;
+
+  return 0;
+}
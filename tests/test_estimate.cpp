@@ -0,0 +1,103 @@
+#include "hoax.h"
+#include "estimate.h"
+#include <cassert>
+
+/** Build the game with controllable AP "c" and uncontrollable APs "u", "v":
+      0 -[c]-> 1 {0},  0 -[!c]-> 0 {1},
+      1 -[u & v]-> 0 {mark_1_0},  1 -[!(u & v)]-> 1 {2}
+    under the "parity max even 4" condition. State 0 depends on no
+    uncontrollable AP, and state 1 on two of them. Eve wins iff. mark_1_0
+    is even, since Adam can always return to 0. */
+spot::twa_graph_ptr make_game(const unsigned int mark_1_0) {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  const bdd v = bdd_ithvar(aut->register_ap("v"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(4, spot::acc_cond::acc_code::parity_max_even(4));
+
+  aut->new_states(2);
+  aut->set_init_state(0);
+  aut->new_edge(0, 1, c, {0});
+  aut->new_edge(0, 0, !c, {1});
+  aut->new_edge(1, 0, u & v, {mark_1_0});
+  aut->new_edge(1, 1, !(u & v), {2});
+  return aut;
+}
+
+int test_parse_engine() {
+  for (const hoax::Engine engine : {hoax::ENGINE_AUTO, hoax::ENGINE_EXPLICIT, hoax::ENGINE_SPOT})
+    assert(hoax::parse_engine(hoax::engine_name(engine)) == engine);
+
+  bool thrown = false;
+  try {
+    hoax::parse_engine("symbolic");
+  } catch (std::runtime_error &e) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  return 0;
+}
+
+int test_estimate_expansion() {
+  spot::twa_graph_ptr aut = make_game(1);
+  const hoax::ExpansionEstimate estimate = hoax::estimate_expansion(aut);
+
+  /* 2 source states, 1 evaluation of state 0 and 4 evaluations of state 1,
+    each with an edge in and 2 edges out. */
+  assert(estimate.max_uncontrollable == 2);
+  assert(estimate.states == 2 + 1 + 4);
+  assert(estimate.edges == 3 + 4 * 3);
+  assert(estimate.bytes == estimate.states * ESTIMATE_STATE_BYTES + estimate.edges * ESTIMATE_EDGE_BYTES);
+
+  /* The estimate is an upper bound of the expansion. */
+  hoax::HOAxParityTwA hptwa(aut, std::make_shared<hoax::CancelToken>());
+  assert(hptwa.exp->num_states() <= estimate.states);
+  assert(hptwa.exp->num_edges() <= estimate.edges);
+
+  return 0;
+}
+
+int test_choose_engine() {
+  hoax::ExpansionEstimate estimate;
+  estimate.bytes = 1000;
+
+  assert(hoax::choose_engine(estimate, 0) == hoax::ENGINE_EXPLICIT);
+  assert(hoax::choose_engine(estimate, 1000) == hoax::ENGINE_EXPLICIT);
+  assert(hoax::choose_engine(estimate, 999) == hoax::ENGINE_SPOT);
+
+  return 0;
+}
+
+int test_solve_spot() {
+  /* Spot's solver agrees with the explicit engine, for either winner. */
+  for (const unsigned int mark_1_0 : {0, 3}) {
+    spot::twa_graph_ptr aut = make_game(mark_1_0);
+    hoax::HOAxParityTwA hptwa(aut, std::make_shared<hoax::CancelToken>());
+    const bool realizable = !hptwa.solve_parity_game();
+    assert(realizable == (mark_1_0 == 0));
+    assert(hoax::solve_spot(aut) == realizable);
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_parse_engine();
+  if (ret) return ret;
+
+  ret = test_estimate_expansion();
+  if (ret) return ret;
+
+  ret = test_choose_engine();
+  if (ret) return ret;
+
+  ret = test_solve_spot();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include "hoax.h"
+#include <cassert>
+
+/** Build the game with controllable AP "c" and uncontrollable AP "u":
+      0 -[u & c]-> 0 {1},  0 -[u & !c]-> 1 {1},  0 -[!u]-> 1 {1},
+      1 -[t]-> 0 {0}
+    under the "parity max even 2" condition. */
+spot::twa_graph_ptr make_game() {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(2, spot::acc_cond::acc_code::parity_max_even(2));
+
+  aut->new_states(2);
+  aut->set_init_state(0);
+  aut->new_edge(0, 0, u & c, {1});
+  aut->new_edge(0, 1, u & !c, {1});
+  aut->new_edge(0, 1, !u, {1});
+  aut->new_edge(1, 0, bddtrue, {0});
+  return aut;
+}
+
+int test_contraction() {
+  hoax::HOAxParityTwA hptwa(make_game(), std::make_shared<hoax::CancelToken>());
+
+  /* The expansion creates the "even player" states 2 for !u, 3 for u, and
+    4 for state 1. Only 3 leaves Eve a choice, so 2 and 4 are contracted. */
+  assert(hptwa.exp->num_states() == 5);
+  assert(hptwa.stats.eve_contracted == 2);
+  assert((hptwa.arena_state == std::vector<int>{0, 1, -1, 2, -1}));
+
+  /* The priorities of the contracted states move onto their source states. */
+  const hoax::Arena &arena = hptwa.arena;
+  assert(arena.num_states == 3);
+  assert(arena.num_edges == 5);
+  assert(arena.owner(0) && arena.owner(1) && !arena.owner(2));
+  assert(arena.priority(0) == 1);
+  assert(arena.priority(1) == 0);
+  assert(arena.priority(2) == 1);
+
+  /* Adam always picks !u, so the cycle 0 -> 1 -> 0 has the odd priority 1. */
+  assert(hptwa.solve_parity_game() == PODD);
+  auto winners = hptwa.exp->get_named_prop<std::vector<bool>>(PROP_HOAX_STATE_WINNER);
+  assert(winners != nullptr);
+  assert((*winners == std::vector<bool>(5, PODD)));
+
+  /* A contracted state is forced to move to its single successor. */
+  assert(hptwa.eve_move(2) == 1);
+  assert(hptwa.eve_move(4) == 0);
+
+  return 0;
+}
+
+/** Build the game with controllable AP "c":
+      0 -[c]-> 0 {0},  0 -[!c]-> 0 {1}
+    under the "parity max even 2" condition. */
+spot::twa_graph_ptr make_mixed_game() {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(2, spot::acc_cond::acc_code::parity_max_even(2));
+
+  aut->new_states(1);
+  aut->set_init_state(0);
+  aut->new_edge(0, 0, c, {0});
+  aut->new_edge(0, 0, !c, {1});
+  return aut;
+}
+
+int test_mixed_priorities() {
+  hoax::HOAxParityTwA hptwa(make_mixed_game(), std::make_shared<hoax::CancelToken>());
+
+  /* The single "even player" state 1 has edges of priority 0 and 1, so it
+    keeps the least priority and each edge gets an edge vertex. */
+  assert(hptwa.exp->num_states() == 2);
+  assert(hptwa.stats.eve_contracted == 0);
+  assert(hptwa.stats.edge_vertices == 2);
+  assert((hptwa.arena_state == std::vector<int>{0, 1}));
+
+  const hoax::Arena &arena = hptwa.arena;
+  assert(arena.num_states == 4);
+  assert(arena.num_edges == 5);
+  assert(arena.priority(1) == INT_MIN + 1);
+  assert(arena.priority(2) == 0 && arena.priority(3) == 1);
+  assert(arena.successors(2).size() == 1 && *arena.successors(2).begin() == 0);
+  assert(arena.successors(3).size() == 1 && *arena.successors(3).begin() == 0);
+
+  /* Eve picks "c" and only ever sees priority 0. */
+  assert(hptwa.solve_parity_game() == PEVEN);
+  assert(hptwa.eve_move(1) == 0);
+  for (auto &edge : hptwa.exp->out(1)) {
+    const unsigned int number = hptwa.exp->edge_number(edge);
+    assert(hptwa.edge_target[number] == (edge.acc == spot::acc_cond::mark_t({0}) ? 2 : 3));
+    assert(hptwa.eve_allows(number) == (edge.acc == spot::acc_cond::mark_t({0})));
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_contraction();
+  if (ret) return ret;
+
+  ret = test_mixed_priorities();
+  if (ret) return ret;
+
+  return 0;
+}
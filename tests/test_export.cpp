@@ -0,0 +1,190 @@
+#include "export.h"
+#include "fixtures.h"
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+
+/** Build the arena 0 -> {1}, 1 -> {0, 2}, 2 -> {2}, where 0 is an "odd
+    player" vertex with the default priority. */
+hoax::Arena make_export_arena() {
+  return make_graph_arena({{1}, {0, 2}, {2}}, {true, false, false}, {INT_MIN + 1, 2, 1}, 0, 3);
+}
+
+/** Check that parsing the export specification fails. */
+bool parse_fails(const std::string &spec) {
+  try {
+    hoax::parse_export(spec);
+  } catch (std::runtime_error &) {
+    return true;
+  }
+  return false;
+}
+
+int test_parse_export() {
+  assert(hoax::parse_export("csv").format == hoax::EXPORT_CSV);
+  assert(hoax::parse_export("binary").format == hoax::EXPORT_BINARY);
+  assert(hoax::parse_export("scc").format == hoax::EXPORT_SCC);
+
+  hoax::ExportOptions ball = hoax::parse_export("ball");
+  assert(ball.format == hoax::EXPORT_BALL);
+  assert(ball.radius == EXPORT_DEFAULT_RADIUS && ball.center == -1);
+  ball = hoax::parse_export("ball:3@17");
+  assert(ball.radius == 3 && ball.center == 17);
+  ball = hoax::parse_export("ball:0");
+  assert(ball.radius == 0 && ball.center == -1);
+
+  assert(parse_fails("dot"));
+  assert(parse_fails("csv:1"));
+  assert(parse_fails("ball:"));
+  assert(parse_fails("ball:x"));
+  assert(parse_fails("ball:2@"));
+  assert(parse_fails("ball:2@-1"));
+
+  return 0;
+}
+
+int test_export_csv() {
+  hoax::Arena arena = make_export_arena();
+  std::ostringstream vertices, edges;
+  hoax::export_csv(vertices, edges, arena, {true, false, false});
+  assert(vertices.str() == "vertex,owner,priority,winner\n"
+                           "0,1," + std::to_string(INT_MIN + 1) + ",1\n"
+                           "1,0,2,0\n"
+                           "2,0,1,0\n");
+  assert(edges.str() == "src,dst\n0,1\n1,0\n1,2\n2,2\n");
+
+  /* Unknown winners leave the column empty. */
+  std::ostringstream unknown, ignored;
+  hoax::export_csv(unknown, ignored, arena, {});
+  assert(unknown.str().find("\n1,0,2,\n") != std::string::npos);
+
+  return 0;
+}
+
+int test_export_binary() {
+  hoax::Arena arena = make_export_arena();
+  std::ostringstream out;
+  hoax::export_binary(out, arena, {true, false, false});
+  const std::string data = out.str();
+  assert(data.size() == 8 + 4 * 4 + 8 + 3 * 4 + 3 + 4 * 2 * 4);
+  assert(data.compare(0, 8, EXPORT_BINARY_MAGIC) == 0);
+
+  uint32_t header[4];
+  std::memcpy(header, data.data() + 8, sizeof(header));
+  assert(header[0] == EXPORT_BINARY_VERSION);
+  assert(header[1] == 1);
+  assert(header[2] == 3 && header[3] == 0);
+  uint64_t num_edges;
+  std::memcpy(&num_edges, data.data() + 24, sizeof(num_edges));
+  assert(num_edges == 4);
+
+  int32_t priorities[3];
+  std::memcpy(priorities, data.data() + 32, sizeof(priorities));
+  assert(priorities[1] == 2 && priorities[2] == 1);
+  /* Vertex 0 is owned and won by the "odd player", vertex 1 by neither. */
+  assert(uint8_t(data[44]) == (1 | 2 | 4));
+  assert(uint8_t(data[45]) == 2);
+
+  uint32_t edges[8];
+  std::memcpy(edges, data.data() + 47, sizeof(edges));
+  assert(std::equal(edges, edges + 8, std::vector<uint32_t>({0, 1, 1, 0, 1, 2, 2, 2}).begin()));
+
+  return 0;
+}
+
+int test_export_ball() {
+  hoax::Arena arena = make_export_arena();
+
+  /* Within one edge of vertex 0 are the vertices 0 and 1. */
+  std::ostringstream out;
+  hoax::export_ball(out, arena, {}, 0, 1);
+  const std::string dot = out.str();
+  assert(dot.find("  0 -> 1;") != std::string::npos);
+  assert(dot.find("  1 -> 0;") != std::string::npos);
+  assert(dot.find("  1 -> 2;") == std::string::npos);
+  assert(dot.find("  2 [") == std::string::npos);
+  /* Vertex 1 has a successor outside of the neighbourhood. */
+  assert(dot.find("  1 [label=\"1\\n2\", shape=circle, style=\"filled,dashed\"];") != std::string::npos);
+  /* Vertex 0 has the default priority, which is not shown. */
+  assert(dot.find("  0 [label=\"0\", shape=box];") != std::string::npos);
+
+  bool thrown = false;
+  try {
+    hoax::export_ball(out, arena, {}, 3, 1);
+  } catch (std::runtime_error &) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  return 0;
+}
+
+int test_export_scc() {
+  hoax::Arena arena = make_export_arena();
+
+  /* The components {2} and {0, 1}, in reverse topological order. */
+  std::ostringstream out;
+  assert(hoax::export_scc(out, arena, {true, false, false}) == 2);
+  const std::string dot = out.str();
+  assert(dot.find("  I -> 1;") != std::string::npos);
+  assert(dot.find("  1 -> 0;") != std::string::npos);
+  assert(dot.find("  0 [shape=box, label=\"#0\\n1 vertex\\np 1\", peripheries=2") != std::string::npos);
+  /* Both players win a vertex of {0, 1}, so it is not colored. */
+  assert(dot.find("  1 [shape=box, label=\"#1\\n2 vertices\\np 2\", peripheries=2];") != std::string::npos);
+
+  return 0;
+}
+
+int test_export_large() {
+  /* A cycle through all vertices, whose export spans several buffers. */
+  const uint32_t n = 200000;
+  std::vector<uint32_t> offsets(n + 1), targets(n);
+  for (uint32_t v = 0; v < n; v++) {
+    offsets[v + 1] = v + 1;
+    targets[v] = (v + 1) % n;
+  }
+  hoax::Arena arena = hoax::make_arena(std::move(offsets), std::move(targets),
+                                       std::vector<bool>(n, false), std::vector<int>(n, 0),
+                                       0, true, false, 1);
+
+  std::ostringstream vertices, edges;
+  hoax::export_csv(vertices, edges, arena, {});
+  const std::string csv = edges.str();
+  assert(csv.size() > EXPORT_BUFFER_SIZE);
+  assert(std::count(csv.begin(), csv.end(), '\n') == n + 1);
+  assert(csv.compare(csv.size() - 9, 9, "199999,0\n") == 0);
+
+  /* The whole cycle is a single component. */
+  std::ostringstream scc;
+  assert(hoax::export_scc(scc, arena, {}) == 1);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_parse_export();
+  if (ret) return ret;
+
+  ret = test_export_csv();
+  if (ret) return ret;
+
+  ret = test_export_binary();
+  if (ret) return ret;
+
+  ret = test_export_ball();
+  if (ret) return ret;
+
+  ret = test_export_scc();
+  if (ret) return ret;
+
+  ret = test_export_large();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+#include "hoax.h"
+#include "fixtures.h"
+#include <cassert>
+
+/** Build the game with controllable AP "c" and uncontrollable AP "u":
+      0 -[c]-> 1 {mark_0_1},  0 -[!c]-> 0 {mark_0_0},
+      1 -[u]-> 0 {mark_1_0},  1 -[!u]-> dst_1 {mark_1_1}
+    under the "parity max even 4" condition. The "even player" state of 0
+    gets the priority of both of its edges, and every uncontrollable
+    evaluation of 1 gets its own "even player" state. */
+spot::twa_graph_ptr make_game(const spot::bdd_dict_ptr &dict,
+                              const unsigned int mark_0_1, const unsigned int mark_0_0,
+                              const unsigned int mark_1_0, const unsigned int mark_1_1,
+                              const unsigned int dst_1 = 1) {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(dict);
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(4, spot::acc_cond::acc_code::parity_max_even(4));
+
+  aut->new_states(2);
+  aut->set_init_state(0);
+  aut->new_edge(0, 1, c, {mark_0_1});
+  aut->new_edge(0, 0, !c, {mark_0_0});
+  aut->new_edge(1, 0, u, {mark_1_0});
+  aut->new_edge(1, dst_1, !u, {mark_1_1});
+  return aut;
+}
+
+int test_incremental() {
+  const spot::bdd_dict_ptr dict = spot::make_bdd_dict();
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  /* Eve stays in 0, and sees the even priority 0 forever. */
+  hoax::HOAxParityTwA h1(make_game(dict, 0, 0, 0, 1), token);
+  assert(h1.solve_parity_game() == PEVEN);
+  assert(h1.stats.states_reused == 0);
+  assert(!h1.stats.warm_start);
+
+  /* Only the odd priority of state 1 changed, and Eve's strategy still wins. */
+  hoax::HOAxParityTwA h2(make_game(dict, 0, 0, 0, 3), h1, token);
+  assert(h2.stats.states_reused == 2);
+  assert(h2.solve_parity_game() == PEVEN);
+  assert(h2.stats.warm_start);
+  assert(h2.stats.zielonka_calls == 0);
+
+  /* Every edge is odd now, so Adam wins and the previous solution is not valid. */
+  hoax::HOAxParityTwA h3(make_game(dict, 1, 1, 1, 1), h2, token);
+  assert(h3.stats.states_reused == 2);
+  assert(h3.solve_parity_game() == PODD);
+  assert(!h3.stats.warm_start);
+
+  /* The reused expansion must equal a fresh expansion. */
+  hoax::HOAxParityTwA h3_fresh(make_game(dict, 1, 1, 1, 1), token);
+  assert(h3_fresh.solve_parity_game() == PODD);
+  assert(same_graph(h3.arena, h3_fresh.arena));
+  for (unsigned int state = 0; state < h3.arena.num_states; state++)
+    assert(h3.arena.priority(state) == h3_fresh.arena.priority(state));
+  assert(h3.winners == h3_fresh.winners);
+
+  /* A changed destination in state 1 only reuses state 0. */
+  hoax::HOAxParityTwA h4(make_game(dict, 0, 0, 0, 1, 0), h3, token);
+  assert(h4.stats.states_reused == 1);
+  assert(h4.solve_parity_game() == PEVEN);
+  assert(!h4.stats.warm_start);
+
+  /* Nothing is reused across bdd_dicts. */
+  hoax::HOAxParityTwA h5(make_game(spot::make_bdd_dict(), 0, 0, 0, 1), h1, token);
+  assert(h5.stats.states_reused == 0);
+  assert(h5.solve_parity_game() == PEVEN);
+
+  return 0;
+}
+
+int test_contracted_warm_start() {
+  const spot::bdd_dict_ptr dict = spot::make_bdd_dict();
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  /* Only the least priority among the forced "even player" states of 1 is
+    contracted, which is the state of "u" here. */
+  hoax::HOAxParityTwA h1(make_game(dict, 0, 0, 0, 2), token);
+  assert(h1.stats.eve_contracted == 1);
+  assert(h1.solve_parity_game() == PEVEN);
+
+  /* Swapping the priorities of 1 contracts the state of "!u" instead, so
+    the arenas differ, but the expansion only changed its priorities. */
+  hoax::HOAxParityTwA h2(make_game(dict, 0, 0, 2, 0), h1, token);
+  assert(h2.stats.states_reused == 2);
+  assert(h2.stats.eve_contracted == 1);
+  assert(!same_graph(h1.arena, h2.arena));
+  assert(h2.solve_parity_game() == PEVEN);
+  assert(h2.stats.warm_start);
+  assert(h2.stats.zielonka_calls == 0);
+
+  /* The seeded winners are those that zielonka finds from scratch. */
+  hoax::HOAxParityTwA h2_fresh(make_game(dict, 0, 0, 2, 0), token);
+  assert(h2_fresh.solve_parity_game() == PEVEN);
+  assert(h2.winners == h2_fresh.winners);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_incremental();
+  if (ret) return ret;
+
+  ret = test_contracted_warm_start();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+#include "hoax.h"
+#include "kernels.h"
+#include "certificate.h"
+#include "fixtures.h"
+#include <cassert>
+#include <random>
+
+int test_bitset() {
+  hoax::BitSet set(130);
+  assert(set.empty());
+  assert(set.begin() == set.end());
+
+  for (const int v : {129, 0, 64, 63})
+    set.insert(v);
+  assert(!set.empty());
+  assert(set.size() == 4);
+  assert(set.contains(63) && !set.contains(62));
+  assert(std::vector<int>(set.begin(), set.end()) == std::vector<int>({0, 63, 64, 129}));
+
+  return 0;
+}
+
+int test_set_policies() {
+  const std::set<int> s1 = {1, 3, 5, 70}, s2 = {3, 4, 70, 100};
+
+  /* Every policy computes the same sets as the tree based utilities. */
+  std::set<int> tree1 = hoax::TreeSets::from(s1, 128), tree2 = hoax::TreeSets::from(s2, 128);
+  std::vector<int> vector1 = hoax::VectorSets::from(s1, 128), vector2 = hoax::VectorSets::from(s2, 128);
+  hoax::BitSet bits1 = hoax::BitSets::from(s1, 128), bits2 = hoax::BitSets::from(s2, 128);
+
+  const std::set<int> difference = hoax::operator-(s1, s2);
+  assert(hoax::TreeSets::minus(tree1, tree2) == difference);
+  const std::vector<int> vector_difference = hoax::VectorSets::minus(vector1, vector2);
+  assert(std::set<int>(vector_difference.begin(), vector_difference.end()) == difference);
+  const hoax::BitSet bits_difference = hoax::BitSets::minus(bits1, bits2);
+  assert(std::set<int>(bits_difference.begin(), bits_difference.end()) == difference);
+
+  hoax::VectorSets::add(vector1, {0, 4, 6});
+  assert(vector1 == std::vector<int>({0, 1, 3, 4, 5, 6, 70}));
+  assert(hoax::VectorSets::contains(vector1, 6) && !hoax::VectorSets::contains(vector1, 2));
+
+  const std::set<int> merged = hoax::operator+(s1, s2);
+  const hoax::BitSet bits_union = hoax::BitSets::unite(bits1, bits2);
+  assert(std::set<int>(bits_union.begin(), bits_union.end()) == merged);
+  assert(hoax::TreeSets::unite(tree1, tree2) == merged);
+
+  return 0;
+}
+
+int test_attractor_kernels() {
+  std::mt19937 rng(1);
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  for (unsigned int trial = 0; trial < 100; trial++) {
+    hoax::Arena arena = make_random_arena(2 + rng() % 150, 5, true, rng);
+    const unsigned int n = arena.num_states;
+    hoax::HOAxParityTwA aut(arena, token);
+    aut.strategy.assign(n, -1);
+
+    std::set<int> vertices_all, vertices_odd, vertices_even, target;
+    for (unsigned int v = 0; v < n; v++) {
+      if (rng() % 4 == 0)
+        continue;
+      vertices_all.insert(v);
+      (arena.owner(v) ? vertices_odd : vertices_even).insert(v);
+      if (rng() % 8 == 0)
+        target.insert(v);
+    }
+
+    /* Every set representation attracts the same vertices. */
+    for (const unsigned int player : {PEVEN, PODD}) {
+      const std::set<int> attr = hoax::attractor(vertices_all, vertices_odd, vertices_even, aut, target, player);
+      const std::vector<int> attr_vector = hoax::Kernel<hoax::VectorSets, true>(aut).attractor(
+          hoax::VectorSets::from(vertices_all, n), hoax::VectorSets::from(target, n), player);
+      assert(std::set<int>(attr_vector.begin(), attr_vector.end()) == attr);
+      const hoax::BitSet attr_bits = hoax::Kernel<hoax::BitSets, false>(aut).attractor(
+          hoax::BitSets::from(vertices_all, n), hoax::BitSets::from(target, n), player);
+      assert(std::set<int>(attr_bits.begin(), attr_bits.end()) == attr);
+    }
+  }
+
+  return 0;
+}
+
+int test_solve_kernels() {
+  std::mt19937 rng(2);
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  for (unsigned int trial = 0; trial < 100; trial++) {
+    /* Also an arena too large for the adjacency matrix, where the bitset
+      kernel scans the edges. */
+    const unsigned int n = trial == 0 ? DENSE_MAX_VERTICES + 100 : 2 + rng() % 60;
+    hoax::Arena arena = make_random_arena(n, 5, rng() % 2, rng);
+
+    hoax::HOAxParityTwA tree(arena, token);
+    tree.options.sets = hoax::SETS_TREE;
+    const bool winner = tree.solve_parity_game();
+    assert(tree.dense == nullptr);
+    assert(hoax::check_solution(arena, tree.winners, tree.strategy).empty());
+
+    for (const hoax::SetPolicy sets : {hoax::SETS_AUTO, hoax::SETS_VECTOR, hoax::SETS_BITSET}) {
+      hoax::HOAxParityTwA hptwa(arena, token);
+      hptwa.options.sets = sets;
+      assert(hptwa.solve_parity_game() == winner);
+      assert(hptwa.winners == tree.winners);
+      assert(hoax::check_solution(arena, hptwa.winners, hptwa.strategy).empty());
+      assert((hptwa.dense != nullptr) == (sets != hoax::SETS_VECTOR && hoax::DenseArena::fits(arena)));
+    }
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_bitset();
+  if (ret) return ret;
+
+  ret = test_set_policies();
+  if (ret) return ret;
+
+  ret = test_attractor_kernels();
+  if (ret) return ret;
+
+  ret = test_solve_kernels();
+  if (ret) return ret;
+
+  return 0;
+}
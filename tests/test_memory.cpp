@@ -0,0 +1,81 @@
+#include "memory.h"
+#include "stats.h"
+#include "fixtures.h"
+#include <cassert>
+#include <vector>
+
+int test_memory_scope() {
+  const size_t size = 1 << 20;
+  hoax::MemoryCounters outer, inner;
+  {
+    hoax::MemoryScope scope_outer(outer);
+    std::vector<char> a(size, 1);
+    {
+      hoax::MemoryScope scope_inner(inner);
+      std::vector<char> b(size, 2);
+      assert(a[0] + b[0] == 3);
+    }
+  }
+
+  /* The process has touched at least the two vectors. */
+  assert(hoax::rss_bytes() > 0);
+  assert(hoax::rss_peak_bytes() >= 2 * size);
+  assert(outer.rss > 0 && inner.rss > 0);
+  assert(outer.rss_growth >= inner.rss_growth);
+
+  if (!hoax::ALLOC_ENABLED) {
+    assert(outer.allocations == 0 && outer.bytes == 0 && outer.heap_peak == 0);
+    return 0;
+  }
+
+  /* The outer scope includes the allocations of the inner one, and both
+    vectors are live at its peak. */
+  assert(inner.allocations >= 1 && inner.bytes >= size && inner.heap_peak >= size);
+  assert(outer.allocations >= inner.allocations + 1);
+  assert(outer.bytes >= 2 * size);
+  assert(outer.heap_peak >= 2 * size);
+
+  return 0;
+}
+
+int test_arena_bytes() {
+  hoax::Arena arena = make_test_arena();
+
+  /* 4 offsets, 4 targets, 1 owner word, 3 table entries and 3 byte codes. */
+  assert(hoax::arena_bytes(arena) == 4 * 4 + 4 * 4 + 8 + 3 * 4 + 3);
+
+  return 0;
+}
+
+int test_memory_json() {
+  hoax::Stats stats;
+  {
+    hoax::MemoryScope memory(stats.memory_solve);
+    std::vector<int> v(1000, 1);
+    assert(v.back() == 1);
+  }
+  const std::string json = stats.to_json("a.ehoa", "REAL", 0, 0);
+  assert(json.find("\"memory\": {\"rss_peak\": ") != std::string::npos);
+  assert(json.find("\"solve\": {\"rss\": ") != std::string::npos);
+  assert(json.find("\"named_props\": 0") != std::string::npos);
+  /* The allocations are only reported if they are counted. */
+  assert((json.find("\"heap_peak\": ") != std::string::npos) == hoax::ALLOC_ENABLED);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_memory_scope();
+  if (ret) return ret;
+
+  ret = test_arena_bytes();
+  if (ret) return ret;
+
+  ret = test_memory_json();
+  if (ret) return ret;
+
+  return 0;
+}
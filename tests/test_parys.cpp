@@ -0,0 +1,91 @@
+#include "hoax.h"
+#include "kernels.h"
+#include "certificate.h"
+#include "fixtures.h"
+#include <cassert>
+#include <random>
+#include <stdexcept>
+
+int test_parse_algorithm() {
+  assert(hoax::parse_algorithm("zielonka") == hoax::ALGORITHM_ZIELONKA);
+  assert(hoax::parse_algorithm("parys") == hoax::ALGORITHM_PARYS);
+  try {
+    hoax::parse_algorithm("mcnaughton");
+    assert(false);
+  } catch (std::runtime_error &) {}
+
+  return 0;
+}
+
+int test_parys_random() {
+  std::mt19937 rng(3);
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  for (unsigned int trial = 0; trial < 200; trial++) {
+    const unsigned int n = 1 + rng() % 80;
+    hoax::Arena arena = make_random_arena(n, 1 + rng() % 10, rng() % 2, rng);
+
+    hoax::HOAxParityTwA zielonka(arena, token);
+    const bool winner = zielonka.solve_parity_game();
+
+    /* Parys' algorithm finds the same winning regions, with strategies
+      that win them, for every set representation. */
+    for (const hoax::SetPolicy sets : {hoax::SETS_TREE, hoax::SETS_VECTOR, hoax::SETS_BITSET}) {
+      hoax::HOAxParityTwA parys(arena, token);
+      parys.options.algorithm = hoax::ALGORITHM_PARYS;
+      parys.options.sets = sets;
+      assert(parys.solve_parity_game() == winner);
+      assert(parys.winners == zielonka.winners);
+      assert(hoax::check_solution(arena, parys.winners, parys.strategy).empty());
+      assert(parys.stats.zielonka_calls > 0);
+      assert(parys.stats.zielonka_depth == 0);
+    }
+  }
+
+  return 0;
+}
+
+int test_parys_derived() {
+  std::mt19937 rng(4);
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  /* The quotient and the reordered arena are solved with the same algorithm. */
+  for (unsigned int trial = 0; trial < 50; trial++) {
+    hoax::Arena arena = make_random_arena(1 + rng() % 60, 1 + rng() % 6, true, rng);
+
+    hoax::HOAxParityTwA zielonka(arena, token);
+    zielonka.solve_parity_game();
+
+    hoax::HOAxParityTwA quotient(arena, token);
+    quotient.options.algorithm = hoax::ALGORITHM_PARYS;
+    quotient.options.quotient = true;
+    quotient.solve_parity_game();
+    assert(quotient.winners == zielonka.winners);
+    assert(hoax::check_solution(arena, quotient.winners, quotient.strategy).empty());
+
+    hoax::HOAxParityTwA reordered(arena, token);
+    reordered.options.algorithm = hoax::ALGORITHM_PARYS;
+    reordered.options.order = hoax::ORDER_BFS;
+    reordered.solve_parity_game();
+    assert(reordered.winners == zielonka.winners);
+    assert(hoax::check_solution(arena, reordered.winners, reordered.strategy).empty());
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_parse_algorithm();
+  if (ret) return ret;
+
+  ret = test_parys_random();
+  if (ret) return ret;
+
+  ret = test_parys_derived();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include "perf.h"
+#include "stats.h"
+#include <cassert>
+
+/** Keeps the compiler from optimizing away the measured loop. */
+static volatile uint64_t sink = 0;
+
+int test_perf_scope() {
+  hoax::PerfCounters outer, inner;
+  {
+    hoax::PerfScope scope_outer(outer);
+    for (uint64_t i = 0; i < 1000000; i++)
+      sink = sink + i;
+    {
+      hoax::PerfScope scope_inner(inner);
+      for (uint64_t i = 0; i < 1000000; i++)
+        sink = sink + i;
+    }
+  }
+
+  if (!hoax::PERF_ENABLED || !hoax::perf_available()) {
+    /* Compiled out, or not permitted: nothing is counted. */
+    assert(outer.cycles == 0 && outer.instructions == 0);
+    assert(inner.cycles == 0 && inner.instructions == 0);
+    return 0;
+  }
+
+  /* Every iteration takes several instructions, and the outer scope
+    includes the inner one. */
+  assert(inner.instructions >= 1000000);
+  assert(outer.instructions >= inner.instructions);
+  assert(outer.cycles > 0);
+
+  return 0;
+}
+
+int test_perf_add() {
+  hoax::PerfCounters a, b;
+  a.cycles = 1;
+  a.llc_misses = 2;
+  b.cycles = 3;
+  b.instructions = 4;
+  b.branch_misses = 5;
+  a.add(b);
+  assert(a.cycles == 4 && a.instructions == 4 && a.llc_misses == 2 && a.branch_misses == 5);
+
+  return 0;
+}
+
+int test_perf_json() {
+  hoax::Stats stats;
+  const std::string json = stats.to_json("a.ehoa", "REAL", 0, 0);
+  /* The counts are only reported if they are compiled in. */
+  assert((json.find("\"perf\": {\"available\": ") != std::string::npos) == hoax::PERF_ENABLED);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_perf_scope();
+  if (ret) return ret;
+
+  ret = test_perf_add();
+  if (ret) return ret;
+
+  ret = test_perf_json();
+  if (ret) return ret;
+
+  return 0;
+}
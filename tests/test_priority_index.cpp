@@ -0,0 +1,63 @@
+#include "priority_index.h"
+#include "fixtures.h"
+#include <cassert>
+
+/** Build a cycle 0 -> 1 -> 2 -> 3 -> 0 with the given priorities. */
+hoax::Arena make_cycle_arena(const std::vector<int> &priorities) {
+  return make_graph_arena({{1}, {2}, {3}, {0}}, {true, false, true, false}, priorities, 0, 6);
+}
+
+int test_extremum() {
+  hoax::Arena arena = make_cycle_arena({2, 5, 2, 1});
+
+  hoax::PriorityIndex index_max(arena, {0, 1, 2, 3}, true);
+  assert(!index_max.empty());
+  assert(index_max.extremum() == 5);
+  assert(index_max.extremum_vertices() == std::set<int>({1}));
+
+  hoax::PriorityIndex index_min(arena, {0, 1, 2, 3}, false);
+  assert(index_min.extremum() == 1);
+  assert(index_min.extremum_vertices() == std::set<int>({3}));
+
+  /* Only the indexed vertices count. */
+  hoax::PriorityIndex index_sub(arena, {0, 2, 3}, true);
+  assert(index_sub.extremum() == 2);
+  assert(index_sub.extremum_vertices() == std::set<int>({0, 2}));
+
+  return 0;
+}
+
+int test_erase_insert() {
+  hoax::Arena arena = make_cycle_arena({2, 5, 2, 1});
+  hoax::PriorityIndex index(arena, {0, 1, 2, 3}, true);
+
+  /* Removing the extremum reveals the next priority. */
+  index.erase({1});
+  assert(index.extremum() == 2);
+  assert(index.extremum_vertices() == std::set<int>({0, 2}));
+  index.erase({0, 2});
+  assert(index.extremum() == 1);
+  index.erase({3});
+  assert(index.empty());
+
+  /* Inserting restores the original sub-game. */
+  index.insert({0, 1, 2, 3});
+  assert(!index.empty());
+  assert(index.extremum() == 5);
+  assert(index.extremum_vertices() == std::set<int>({1}));
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_extremum();
+  if (ret) return ret;
+
+  ret = test_erase_insert();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+#include "hoax.h"
+#include "properties.h"
+#include <cassert>
+
+/** Build the game with controllable AP "c" and uncontrollable AP "u", with
+    state based acceptance under the "parity max even 2" condition:
+      0 {1}: -[u & c]-> 0,  -[u & !c]-> 1,  -[!u]-> 1
+      1 {0}: -[t]-> 0
+    If `declare`, then it declares that it is deterministic, complete and
+    has state based acceptance, which all hold. */
+spot::twa_graph_ptr make_game(const bool declare) {
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(2, spot::acc_cond::acc_code::parity_max_even(2));
+
+  aut->new_states(2);
+  aut->set_init_state(0);
+  aut->new_edge(0, 0, u & c, {1});
+  aut->new_edge(0, 1, u & !c, {1});
+  aut->new_edge(0, 1, !u, {1});
+  aut->new_edge(1, 0, bddtrue, {0});
+  if (declare) {
+    aut->prop_state_acc(true);
+    aut->prop_universal(true);
+    aut->prop_complete(true);
+  }
+  return aut;
+}
+
+int test_declared_properties() {
+  const hoax::GameProperties none = hoax::declared_properties(make_game(false));
+  assert(!none.state_acc && !none.deterministic && !none.complete);
+  assert(none.names().empty());
+
+  const hoax::GameProperties all = hoax::declared_properties(make_game(true));
+  assert(all.state_acc && all.deterministic && all.complete);
+  assert(all.names() == "state-acc deterministic complete");
+  assert(hoax::check_properties(make_game(true), all).empty());
+
+  return 0;
+}
+
+int test_check_properties() {
+  hoax::GameProperties all;
+  all.state_acc = all.deterministic = all.complete = true;
+
+  /* An edge that overlaps another one, in another acceptance set. */
+  spot::twa_graph_ptr aut = make_game(true);
+  aut->new_edge(1, 1, bdd_ithvar(aut->register_ap("u")), {1});
+  assert(hoax::check_properties(aut, all) == "deterministic");
+  all.deterministic = false;
+  assert(hoax::check_properties(aut, all) == "state-acc");
+  all.state_acc = false;
+  assert(hoax::check_properties(aut, all).empty());
+
+  /* A state that leaves "!u & !c" without a move. */
+  aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  aut->new_states(1);
+  aut->new_edge(0, 0, u | c);
+  assert(hoax::check_properties(aut, all) == "complete");
+
+  return 0;
+}
+
+int test_shortcuts() {
+  /* The shortcuts for the declared properties expand the same game, with
+    the same priorities, as the general case. */
+  hoax::HOAxParityTwA general(make_game(false), std::make_shared<hoax::CancelToken>());
+  hoax::HOAxParityTwA shortcut(make_game(true), std::make_shared<hoax::CancelToken>());
+  assert(shortcut.stats.properties == "state-acc deterministic complete");
+
+  assert(general.exp->num_states() == shortcut.exp->num_states());
+  assert(general.exp->num_edges() == shortcut.exp->num_edges());
+  assert(general.arena_state == shortcut.arena_state);
+  assert(general.arena.num_states == shortcut.arena.num_states);
+  assert(general.arena.num_edges == shortcut.arena.num_edges);
+  for (unsigned int v = 0; v < general.arena.num_states; v++) {
+    assert(general.arena.owner(v) == shortcut.arena.owner(v));
+    assert(general.arena.priority(v) == shortcut.arena.priority(v));
+  }
+
+  assert(general.solve_parity_game() == shortcut.solve_parity_game());
+  assert(general.winners == shortcut.winners);
+
+  return 0;
+}
+
+int test_false_complete() {
+  /* A game that declares to be complete, but leaves Adam's "!u" without
+    an edge, still expands into an arena without dead ends. */
+  spot::twa_graph_ptr aut = spot::make_twa_graph(spot::make_bdd_dict());
+  const bdd c = bdd_ithvar(aut->register_ap("c"));
+  const bdd u = bdd_ithvar(aut->register_ap("u"));
+  spot::set_synthesis_outputs(aut, c);
+  aut->set_acceptance(2, spot::acc_cond::acc_code::parity_max_even(2));
+  aut->new_states(1);
+  aut->set_init_state(0);
+  aut->new_edge(0, 0, u & c, {0});
+  aut->prop_complete(true);
+
+  hoax::HOAxParityTwA hptwa(aut, std::make_shared<hoax::CancelToken>());
+  assert(hptwa.stats.evals_skipped == 1);
+  for (unsigned int v = 0; v < hptwa.arena.num_states; v++)
+    assert(hptwa.arena.successors(v).size() > 0);
+  assert(hptwa.solve_parity_game() == PEVEN);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_declared_properties();
+  if (ret) return ret;
+
+  ret = test_check_properties();
+  if (ret) return ret;
+
+  ret = test_shortcuts();
+  if (ret) return ret;
+
+  ret = test_false_complete();
+  if (ret) return ret;
+
+  return 0;
+}
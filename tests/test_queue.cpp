@@ -0,0 +1,54 @@
+#include "queue.h"
+#include <cassert>
+#include <thread>
+#include <vector>
+
+int test_queue_order() {
+  /* A capacity of 1 forces the producer to block on every push. */
+  hoax::BoundedQueue<int> queue(1);
+  std::thread producer([&queue]() {
+    for (int i = 0; i < 1000; i++)
+      assert(queue.push(i));
+    queue.close();
+  });
+
+  std::vector<int> popped;
+  while (std::optional<int> item = queue.pop())
+    popped.push_back(*item);
+  producer.join();
+
+  /* Every item arrives exactly once, in FIFO order. */
+  assert(popped.size() == 1000);
+  for (int i = 0; i < 1000; i++)
+    assert(popped[i] == i);
+
+  return 0;
+}
+
+int test_queue_close() {
+  hoax::BoundedQueue<int> queue(2);
+  assert(queue.push(1));
+  assert(queue.push(2));
+  queue.close();
+
+  /* Closing drops new items, but the queued items are still drained. */
+  assert(!queue.push(3));
+  assert(queue.pop() == 1);
+  assert(queue.pop() == 2);
+  assert(!queue.pop().has_value());
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_queue_order();
+  if (ret) return ret;
+
+  ret = test_queue_close();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include "hoax.h"
+#include "quotient.h"
+#include "certificate.h"
+#include "fixtures.h"
+#include <cassert>
+#include <climits>
+
+/** Build the arena
+      0 -> {2, 3}, 1 -> {3, 4}, 2 -> {0}, 3 -> {1}, 4 -> {1}
+    where 0, 1 are "odd player" states, and 2, 3, 4 are "even player" states.
+    All "odd player" resp. "even player" states are bisimilar iff. 4 has the
+    same priority as 2 and 3. */
+hoax::Arena make_bisimilar_arena(const int priority_4) {
+  return make_graph_arena({{2, 3}, {3, 4}, {0}, {1}, {1}}, {true, true, false, false, false},
+                          {INT_MIN + 1, INT_MIN + 1, 2, 2, priority_4}, 0, 3);
+}
+
+int test_quotient() {
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  /* With equal priorities, all "odd player" and all "even player" states
+    collapse into a single class each. */
+  hoax::Quotient equal = hoax::bisimulation_quotient(make_bisimilar_arena(2), token);
+  assert(equal.arena.num_states == 2);
+  assert(equal.class_of[0] == equal.class_of[1]);
+  assert(equal.class_of[2] == equal.class_of[3] && equal.class_of[3] == equal.class_of[4]);
+  assert(equal.arena.init_state == equal.class_of[0]);
+
+  /* A distinct priority for 4 splits 1 from 0, since only 1 moves to 4,
+    which in turn splits 3 from 2. */
+  hoax::Quotient split = hoax::bisimulation_quotient(make_bisimilar_arena(1), token);
+  assert(split.arena.num_states == 5);
+  assert(split.arena.num_edges == 7);
+
+  return 0;
+}
+
+int test_solve_quotient() {
+  auto token = std::make_shared<hoax::CancelToken>();
+
+  for (const int priority_4 : {1, 2, 3}) {
+    hoax::Arena arena = make_bisimilar_arena(priority_4);
+    hoax::HOAxParityTwA full(arena, token);
+    const bool winner = full.solve_parity_game();
+
+    /* The quotient has the same winners, and a valid strategy. */
+    hoax::HOAxParityTwA reduced(arena, token);
+    reduced.options.quotient = true;
+    assert(reduced.solve_parity_game() == winner);
+    assert(reduced.winners == full.winners);
+    assert(reduced.stats.quotient_states == (priority_4 == 2 ? 2 : 5));
+    assert(hoax::check_solution(arena, reduced.winners, reduced.strategy).empty());
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_quotient();
+  if (ret) return ret;
+
+  ret = test_solve_quotient();
+  if (ret) return ret;
+
+  return 0;
+}
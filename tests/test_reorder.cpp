@@ -0,0 +1,101 @@
+#include "hoax.h"
+#include "reorder.h"
+#include "certificate.h"
+#include "fixtures.h"
+#include <cassert>
+
+/** Build the arena
+      0 -> {3}, 1 -> {0}, 2 -> {1}, 3 -> {2, 4}, 4 -> {4}
+    with initial vertex 2, where 1 and 3 are "odd player" vertices. Vertex 4
+    is only reachable through 3. */
+hoax::Arena make_reorder_arena() {
+  return make_graph_arena({{3}, {0}, {1}, {2, 4}, {4}}, {false, true, false, true, false},
+                          {2, 1, 0, 1, 3}, 2, 4);
+}
+
+int test_parse_vertex_order() {
+  assert(hoax::parse_vertex_order("none") == hoax::ORDER_NONE);
+  assert(hoax::parse_vertex_order("bfs") == hoax::ORDER_BFS);
+  assert(hoax::parse_vertex_order("rcm") == hoax::ORDER_RCM);
+  assert(hoax::parse_vertex_order("priority") == hoax::ORDER_PRIORITY);
+
+  bool thrown = false;
+  try {
+    hoax::parse_vertex_order("dfs");
+  } catch (std::runtime_error &e) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  return 0;
+}
+
+int test_reorder_arena() {
+  hoax::Arena arena = make_reorder_arena();
+
+  /* BFS follows the cycle backwards from the initial vertex. */
+  hoax::Reordering bfs = hoax::reorder_arena(arena, hoax::ORDER_BFS);
+  assert(bfs.old_of == std::vector<uint32_t>({2, 1, 0, 3, 4}));
+  assert(bfs.arena.init_state == 0);
+  assert(bfs.arena.num_edges == arena.num_edges);
+
+  /* The arena is the same up to the renumbering. */
+  for (uint32_t v = 0; v < arena.num_states; v++) {
+    const uint32_t w = bfs.new_of[v];
+    assert(bfs.old_of[w] == v);
+    assert(bfs.arena.owner(w) == arena.owner(v));
+    assert(bfs.arena.priority(w) == arena.priority(v));
+    assert(bfs.arena.successors(w).size() == arena.successors(v).size());
+    for (const uint32_t dst : arena.successors(v)) {
+      bool found = false;
+      for (const uint32_t dst_new : bfs.arena.successors(w))
+        found |= dst_new == bfs.new_of[dst];
+      assert(found);
+    }
+  }
+
+  /* Grouping by priority, then by owner. */
+  hoax::Reordering priority = hoax::reorder_arena(arena, hoax::ORDER_PRIORITY);
+  assert(priority.old_of == std::vector<uint32_t>({2, 1, 3, 0, 4}));
+
+  /* RCM is a permutation that ends at the initial vertex. */
+  hoax::Reordering rcm = hoax::reorder_arena(arena, hoax::ORDER_RCM);
+  assert(rcm.old_of.size() == arena.num_states);
+  assert(rcm.old_of.back() == arena.init_state);
+
+  return 0;
+}
+
+int test_solve_reordered() {
+  auto token = std::make_shared<hoax::CancelToken>();
+  hoax::Arena arena = make_reorder_arena();
+  hoax::HOAxParityTwA plain(arena, token);
+  const bool winner = plain.solve_parity_game();
+
+  /* Every order has the same winners, and a valid strategy. */
+  for (const hoax::VertexOrder order : {hoax::ORDER_BFS, hoax::ORDER_RCM, hoax::ORDER_PRIORITY}) {
+    hoax::HOAxParityTwA reordered(arena, token);
+    reordered.options.order = order;
+    assert(reordered.solve_parity_game() == winner);
+    assert(reordered.winners == plain.winners);
+    assert(hoax::check_solution(arena, reordered.winners, reordered.strategy).empty());
+  }
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_parse_vertex_order();
+  if (ret) return ret;
+
+  ret = test_reorder_arena();
+  if (ret) return ret;
+
+  ret = test_solve_reordered();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include "hoax.h"
+#include "stats.h"
+#include "fixtures.h"
+#include <cassert>
+
+int test_json_string() {
+  assert(hoax::json_string("input/a.ehoa") == "\"input/a.ehoa\"");
+  assert(hoax::json_string("a\"b\\c") == "\"a\\\"b\\\\c\"");
+  assert(hoax::json_string("a\tb\nc") == "\"a\\tb\\nc\"");
+  assert(hoax::json_string(std::string(1, '\x01')) == "\"\\u0001\"");
+
+  return 0;
+}
+
+int test_solver_counters() {
+  hoax::Arena arena = make_test_arena();
+
+  hoax::HOAxParityTwA hptwa(arena, std::make_shared<hoax::CancelToken>());
+  /* Count the edges of the sparse attractor, the dense one scans rows. */
+  hptwa.options.sets = hoax::SETS_TREE;
+  hptwa.solve_parity_game();
+
+  const hoax::Stats &stats = hptwa.stats;
+  assert(stats.zielonka_calls >= 2);
+  assert(stats.zielonka_depth == 0);
+  assert(stats.zielonka_depth_max >= 2);
+  assert(stats.attractor_calls >= 1);
+  assert(stats.attractor_rounds >= stats.attractor_calls);
+  assert(stats.edges_scanned > 0);
+  assert(stats.time_solve >= 0);
+
+  const std::string json = stats.to_json("a.ehoa", "REAL", arena.num_states, arena.num_edges);
+  assert(json.front() == '{' && json.back() == '}');
+  assert(json.find("\"result\": \"REAL\"") != std::string::npos);
+  assert(json.find("\"states\": 3") != std::string::npos);
+  assert(json.find("\"certificate\": \"unchecked\"") != std::string::npos);
+  assert(json.find('\n') == std::string::npos);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_json_string();
+  if (ret) return ret;
+
+  ret = test_solver_counters();
+  if (ret) return ret;
+
+  return 0;
+}
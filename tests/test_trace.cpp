@@ -0,0 +1,109 @@
+#include "hoax.h"
+#include "trace.h"
+#include "fixtures.h"
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+/* Get an argument of an event, or -1 if it has none of that name. */
+static int64_t get_arg(const hoax::TraceEvent &event, const char *name) {
+  for (unsigned int i = 0; i < event.num_args; i++)
+    if (strcmp(event.arg_names[i], name) == 0)
+      return event.arg_values[i];
+  return -1;
+}
+
+int test_trace_frames() {
+  const hoax::Arena arena = make_test_arena();
+  for (const hoax::SetPolicy sets : {hoax::SETS_TREE, hoax::SETS_VECTOR, hoax::SETS_BITSET}) {
+    hoax::HOAxParityTwA hptwa(arena, std::make_shared<hoax::CancelToken>());
+    hptwa.options.sets = sets;
+    hptwa.options.tracer = std::make_shared<hoax::Tracer>();
+    hptwa.solve_parity_game();
+
+    /* Every frame and attractor call is recorded, and the solve span ends last. */
+    const std::vector<hoax::TraceEvent> &events = hptwa.options.tracer->events();
+    uint64_t frames = 0, attractors = 0;
+    for (const hoax::TraceEvent &event : events) {
+      assert(event.start >= 0 && event.duration >= 0);
+      if (strcmp(event.name, "zielonka") == 0) {
+        frames++;
+        assert(get_arg(event, "depth") >= 1);
+        /* The root frame is the whole arena. */
+        if (get_arg(event, "depth") == 1)
+          assert(get_arg(event, "size") == arena.num_states);
+      } else if (strcmp(event.name, "attractor") == 0) {
+        attractors++;
+        assert(get_arg(event, "attractor") >= get_arg(event, "target"));
+        assert(get_arg(event, "rounds") >= 1);
+      }
+    }
+    assert(frames == hptwa.stats.zielonka_calls);
+    assert(attractors == hptwa.stats.attractor_calls);
+    assert(strcmp(events.back().name, "solve") == 0);
+    assert(get_arg(events.back(), "states") == arena.num_states);
+
+    /* A span contains the spans that ended before it and started after it. */
+    for (const hoax::TraceEvent &event : events)
+      assert(event.start + event.duration <= events.back().start + events.back().duration);
+  }
+
+  return 0;
+}
+
+int test_trace_dropped() {
+  const hoax::Arena arena = make_test_arena();
+  hoax::HOAxParityTwA hptwa(arena, std::make_shared<hoax::CancelToken>());
+  hptwa.options.tracer = std::make_shared<hoax::Tracer>(2);
+  hptwa.solve_parity_game();
+
+  /* A full tracer keeps its first events, and counts the others. */
+  assert(hptwa.options.tracer->events().size() == 2);
+  assert(hptwa.options.tracer->num_dropped() > 0);
+
+  return 0;
+}
+
+int test_trace_json() {
+  hoax::Tracer tracer;
+  {
+    hoax::TraceScope scope(&tracer, "zielonka");
+    scope.arg("depth", 1);
+    scope.arg("priority", -3);
+  }
+  {
+    /* A disabled scope records nothing. */
+    hoax::TraceScope scope(nullptr, "attractor");
+    assert(!scope.enabled());
+    scope.arg("depth", 1);
+  }
+  assert(tracer.events().size() == 1);
+
+  std::ostringstream os;
+  tracer.write(os, "a\"b.ehoa");
+  const std::string json = os.str();
+  assert(json.front() == '{');
+  assert(json.find("\"traceEvents\": [") != std::string::npos);
+  assert(json.find("\"name\": \"zielonka\", \"cat\": \"solver\", \"ph\": \"X\"") != std::string::npos);
+  assert(json.find("\"args\": {\"depth\": 1, \"priority\": -3}") != std::string::npos);
+  assert(json.find("\"a\\\"b.ehoa\"") != std::string::npos);
+  assert(json.find("\"dropped\": 0") != std::string::npos);
+
+  return 0;
+}
+
+int main()
+{
+  int ret = 0;
+
+  ret = test_trace_frames();
+  if (ret) return ret;
+
+  ret = test_trace_dropped();
+  if (ret) return ret;
+
+  ret = test_trace_json();
+  if (ret) return ret;
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include "hoax.h"
+#include <cassert>
+#include <spot/parseaut/public.hh>
+
+/** Solve a benchmark game with hoax and with spot's baseline.
+
+    @param[in] path_in The path to the eHOA input file of the parity game
+    @param[in] realizable The expected verdict, true iff. REAL
+*/
+int test_verdict(const std::string &path_in, const bool realizable) {
+  auto pa = spot::parse_aut(path_in, spot::make_bdd_dict());
+  assert(!pa->aborted && pa->aut != nullptr);
+
+  hoax::HOAxParityTwA hptwa(pa->aut, std::make_shared<hoax::CancelToken>());
+  assert(!hptwa.solve_parity_game() == realizable);
+  assert(hoax::solve_spot(pa->aut) == realizable);
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  assert(argc >= 2);  // Require the input path.
+  std::string dir_in  = argv[1];
+  int ret = 0;
+
+  /* Every other game has state based acceptance, but "min-odd-2" has
+    "even player" states whose edges have different priorities. */
+  ret = test_verdict(dir_in + "/hoa_benchmarks/diff-ACCs-min-odd-2.ehoa", true);
+  if (ret) return ret;
+
+  ret = test_verdict(dir_in + "/hoa_benchmarks/diff-ACCs-min-odd-3.ehoa", false);
+  if (ret) return ret;
+
+  ret = test_verdict(dir_in + "/hoa_benchmarks/diff-ACCs-max-even-2.ehoa", true);
+  if (ret) return ret;
+
+  ret = test_verdict(dir_in + "/hoa_benchmarks/diff-ACCs-max-even-3.ehoa", true);
+  if (ret) return ret;
+
+  return 0;
+}